@@ -0,0 +1,65 @@
+#ifndef ASSIGNMENTS_DG_BFS_H_
+#define ASSIGNMENTS_DG_BFS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+#include "assignments/dg/parallel.h"
+
+namespace gdwg {
+
+// Breadth first search over a frozen graph, split across threads.
+// Each level is expanded either top-down, from the frontier along out-edges, or bottom-up,
+// where every unvisited node looks along its in-edges for a parent in the frontier. The
+// search switches to bottom-up once the frontier has more edges than are left unexplored,
+// and back when the frontier shrinks again.
+// Its threads are started once and reused by every search. Searches run on one Bfs from
+// several threads at once share them, taking turns a level at a time.
+// The snapshot has to outlive this object.
+template <typename N, typename E>
+class Bfs {
+ public:
+  // Level of a node that can't be reached
+  static constexpr std::size_t kUnreached = SIZE_MAX;
+
+  // threads = 0 uses one per core
+  explicit Bfs<N, E>(const CsrGraph<N, E>& g, unsigned threads = 0);
+
+  // Checks if there is a path from src to dst, of any length
+  bool Reachable(const N& src, const N& dst) const;
+  // Number of hops from src to every node, indexed the same way as CsrGraph::ValueAt
+  std::vector<std::size_t> BfsLevels(const N& src) const;
+
+ private:
+  // Sizes the switching decisions use, from Beamer et al.
+  static constexpr std::size_t kAlpha = 14;
+  static constexpr std::size_t kBeta = 24;
+  // Items each thread grabs at a time, and the least work worth waking threads for
+  static constexpr std::size_t kChunk = 1024;
+
+  using Bitmap = std::vector<std::atomic<std::uint64_t>>;
+
+  const CsrGraph<N, E>& graph;
+  // In-edges, for bottom-up steps
+  CsrGraph<N, E> reverse;
+  unsigned threads;
+  // Kept for every search, behind a pointer so a Bfs can still be moved
+  std::unique_ptr<detail::WorkerPool> pool;
+
+  // Runs the search from src, stopping early once stop is visited if it is a node
+  std::vector<std::size_t> search(std::uint32_t src, std::uint32_t stop) const;
+  // Calls fn(first, last, thread) over chunks of [0, count) on every thread
+  template <typename F>
+  void parallelFor(std::size_t count, F fn) const {
+    pool->For(count, kChunk, fn);
+  }
+};
+
+}  // namespace gdwg
+#include "assignments/dg/bfs.tpp"
+
+#endif  // ASSIGNMENTS_DG_BFS_H_
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::Bfs<N, E>::Bfs(const CsrGraph<N, E>& g, unsigned threadCount)
+  : graph{g}, reverse{g.Transpose()}, threads{threadCount} {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  pool = std::make_unique<detail::WorkerPool>(threads);
+}
+
+// Checks if there is a path from src to dst
+template <typename N, typename E>
+bool gdwg::Bfs<N, E>::Reachable(const N& src, const N& dst) const {
+  auto s = graph.IndexOf(src);
+  auto d = graph.IndexOf(dst);
+  if (s == graph.NodeCount() || d == graph.NodeCount()) {
+    throw std::runtime_error(
+        "Cannot call Bfs::Reachable if src or dst node don't exist in the graph");
+  }
+  if (s == d)
+    return true;
+  auto levels = search(static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(d));
+  return levels[d] != kUnreached;
+}
+
+// Finds the number of hops from src to every node
+template <typename N, typename E>
+std::vector<std::size_t> gdwg::Bfs<N, E>::BfsLevels(const N& src) const {
+  auto s = graph.IndexOf(src);
+  if (s == graph.NodeCount()) {
+    throw std::out_of_range("Cannot call Bfs::BfsLevels if src doesn't exist in the graph");
+  }
+  return search(static_cast<std::uint32_t>(s), static_cast<std::uint32_t>(graph.NodeCount()));
+}
+
+template <typename N, typename E>
+std::vector<std::size_t> gdwg::Bfs<N, E>::search(std::uint32_t src, std::uint32_t stop) const {
+  const auto n = graph.NodeCount();
+  const auto words = (n + 63) / 64;
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  const auto& inOffsets = reverse.Offsets();
+  const auto& inSources = reverse.Destinations();
+  const auto degree = [&offsets](std::uint32_t v) { return offsets[v + 1] - offsets[v]; };
+  const auto test = [](const Bitmap& bits, std::uint32_t v) {
+    return (bits[v / 64].load(std::memory_order_relaxed) >> (v % 64)) & 1;
+  };
+
+  std::vector<std::size_t> levels(n, kUnreached);
+  Bitmap visited(words);
+  Bitmap frontierBits(words);
+  Bitmap nextBits(words);
+  std::vector<std::uint32_t> frontier{src};
+  levels[src] = 0;
+  visited[src / 64].store(std::uint64_t{1} << (src % 64), std::memory_order_relaxed);
+
+  // Counts from each thread, only added up between levels
+  std::vector<detail::Padded<std::size_t>> found(threads);
+  std::vector<detail::Padded<std::size_t>> foundEdges(threads);
+  std::vector<std::vector<std::uint32_t>> next(threads);
+  std::size_t frontierSize = 1;
+  std::size_t unexplored = graph.EdgeCount() - degree(src);
+  bool bottomUp = false;
+
+  for (std::size_t depth = 1; frontierSize > 0; ++depth) {
+    if (stop < n && levels[stop] != kUnreached)
+      break;
+    if (!bottomUp) {
+      std::size_t frontierEdges = 0;
+      for (const auto& u : frontier) {
+        frontierEdges += degree(u);
+      }
+      if (frontierEdges > unexplored / kAlpha) {
+        bottomUp = true;
+        for (auto& word : frontierBits) {
+          word.store(0, std::memory_order_relaxed);
+        }
+        for (const auto& u : frontier) {
+          frontierBits[u / 64].fetch_or(std::uint64_t{1} << (u % 64), std::memory_order_relaxed);
+        }
+      }
+    } else if (frontierSize < n / kBeta) {
+      bottomUp = false;
+      frontier.clear();
+      for (std::size_t w = 0; w < words; ++w) {
+        for (auto bits = frontierBits[w].load(std::memory_order_relaxed); bits != 0;
+             bits &= bits - 1) {
+          frontier.push_back(static_cast<std::uint32_t>(w * 64 + __builtin_ctzll(bits)));
+        }
+      }
+    }
+
+    std::fill(found.begin(), found.end(), detail::Padded<std::size_t>{});
+    std::fill(foundEdges.begin(), foundEdges.end(), detail::Padded<std::size_t>{});
+    if (bottomUp) {
+      // Each thread owns whole words, so nothing it writes is shared
+      parallelFor(words, [&](std::size_t first, std::size_t last, unsigned t) {
+        for (auto w = first; w < last; ++w) {
+          auto seen = visited[w].load(std::memory_order_relaxed);
+          auto unseen = ~seen;
+          if (w == words - 1 && n % 64 != 0)
+            unseen &= (std::uint64_t{1} << (n % 64)) - 1;
+          std::uint64_t added = 0;
+          for (; unseen != 0; unseen &= unseen - 1) {
+            auto v = static_cast<std::uint32_t>(w * 64 + __builtin_ctzll(unseen));
+            for (auto e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+              if (test(frontierBits, inSources[e])) {
+                added |= std::uint64_t{1} << (v % 64);
+                levels[v] = depth;
+                ++found[t].value;
+                foundEdges[t].value += degree(v);
+                break;
+              }
+            }
+          }
+          nextBits[w].store(added, std::memory_order_relaxed);
+          visited[w].store(seen | added, std::memory_order_relaxed);
+        }
+      });
+      std::swap(frontierBits, nextBits);
+    } else {
+      parallelFor(frontier.size(), [&](std::size_t first, std::size_t last, unsigned t) {
+        for (auto i = first; i < last; ++i) {
+          auto u = frontier[i];
+          for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+            auto v = destinations[e];
+            auto bit = std::uint64_t{1} << (v % 64);
+            // Only the thread that sets the bit claims v
+            if (test(visited, v) ||
+                (visited[v / 64].fetch_or(bit, std::memory_order_relaxed) & bit) != 0)
+              continue;
+            levels[v] = depth;
+            next[t].push_back(v);
+            foundEdges[t].value += degree(v);
+          }
+        }
+      });
+      frontier.clear();
+      for (auto& part : next) {
+        frontier.insert(frontier.end(), part.begin(), part.end());
+        found[0].value += part.size();
+        part.clear();
+      }
+    }
+
+    frontierSize = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+      frontierSize += found[t].value;
+      unexplored -= foundEdges[t].value;
+    }
+  }
+  return levels;
+}
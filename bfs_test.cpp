@@ -0,0 +1,107 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Levels and reachability are first checked on a small graph that can be worked
+  out by hand, with a cycle, a dead end and a node nothing points to.
+
+  A larger generated graph is then searched with one thread and with several,
+  and both are compared against a plain queue based BFS. The graph has a hub
+  pointing at every node so the search goes bottom-up for the middle levels,
+  and a long chain so it has to come back to top-down for the tail.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <deque>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/bfs.h"
+#include "catch.h"
+
+SCENARIO("Testing BFS on a small graph") {
+  GIVEN("A graph with a cycle and an unreachable node") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d", "e"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "c", 1);
+    g.InsertEdge("c", "a", 1);
+    g.InsertEdge("c", "d", 1);
+    g.InsertEdge("e", "a", 1);
+    auto csr = g.Freeze();
+    gdwg::Bfs<std::string, int> bfs{csr, 1};
+
+    WHEN("Levels are found from a") {
+      auto levels = bfs.BfsLevels("a");
+      THEN("Each node is its number of hops away") {
+        REQUIRE(levels[csr.IndexOf("a")] == 0);
+        REQUIRE(levels[csr.IndexOf("b")] == 1);
+        REQUIRE(levels[csr.IndexOf("c")] == 2);
+        REQUIRE(levels[csr.IndexOf("d")] == 3);
+        REQUIRE(levels[csr.IndexOf("e")] == gdwg::Bfs<std::string, int>::kUnreached);
+      }
+    }
+    WHEN("Reachability is checked") {
+      THEN("Paths of any length count, but edges only go one way") {
+        REQUIRE(bfs.Reachable("a", "d"));
+        REQUIRE(bfs.Reachable("e", "d"));
+        REQUIRE(bfs.Reachable("d", "d"));
+        REQUIRE(!bfs.Reachable("a", "e"));
+        REQUIRE(!bfs.Reachable("d", "a"));
+      }
+    }
+    WHEN("Missing nodes are used") {
+      THEN("An exception is thrown") {
+        REQUIRE_THROWS_AS(bfs.Reachable("a", "z"), std::runtime_error);
+        REQUIRE_THROWS_AS(bfs.BfsLevels("z"), std::out_of_range);
+      }
+    }
+  }
+}
+
+SCENARIO("Testing BFS on a large graph") {
+  GIVEN("A hub, a sparse random part and a long chain") {
+    const int size = 20000;
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int i = 1; i < size / 2; ++i) {
+      edges.emplace_back(0, i, 0);
+      edges.emplace_back(i, (i * 7919) % (size / 2), 0);
+    }
+    for (int i = size / 2 - 1; i < size - 1; ++i) {
+      edges.emplace_back(i, i + 1, 0);
+    }
+    auto csr = gdwg::Graph<int, int>::FromEdgeList(edges).Freeze();
+
+    // Plain BFS to compare against
+    std::vector<std::size_t> expected(csr.NodeCount(), gdwg::Bfs<int, int>::kUnreached);
+    std::deque<std::size_t> queue{csr.IndexOf(1)};
+    expected[csr.IndexOf(1)] = 0;
+    while (!queue.empty()) {
+      auto u = queue.front();
+      queue.pop_front();
+      for (auto e = csr.Offsets()[u]; e < csr.Offsets()[u + 1]; ++e) {
+        auto v = csr.Destinations()[e];
+        if (expected[v] == gdwg::Bfs<int, int>::kUnreached) {
+          expected[v] = expected[u] + 1;
+          queue.push_back(v);
+        }
+      }
+    }
+    expected[csr.IndexOf(1)] = 0;
+
+    WHEN("It is searched from the hub with different numbers of threads") {
+      gdwg::Bfs<int, int> one{csr, 1};
+      gdwg::Bfs<int, int> many{csr, 4};
+      THEN("Both give the same levels as a plain BFS") {
+        auto levels = one.BfsLevels(0);
+        REQUIRE(levels[csr.IndexOf(size - 1)] == size / 2 + 1);
+        REQUIRE(many.BfsLevels(0) == levels);
+        REQUIRE(many.BfsLevels(1) == expected);
+        REQUIRE(one.BfsLevels(1) == expected);
+        REQUIRE(many.Reachable(0, size - 1));
+        REQUIRE(!many.Reachable(size - 1, 0));
+      }
+    }
+  }
+}
@@ -0,0 +1,135 @@
+#ifndef ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
+#define ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+
+namespace gdwg {
+
+namespace detail {
+
+// Where a decoder is in a CompressedGraph. pos is the byte after edge's destination
+struct RowCursor {
+  std::size_t node = 0;
+  std::size_t edge = 0;
+  std::uint32_t dest = 0;
+  std::size_t pos = 0;
+};
+
+}  // namespace detail
+
+// Read-only form of a frozen graph with its out-edge lists compressed.
+// Destinations in each row are sorted, so they're stored as varint gaps from the one before,
+// and the first as a gap from the row's own index. Every kBlockSize edges a row has a skip
+// entry with the destination and byte offset there, kept inline at the start of the row,
+// so seeking to a destination decodes at most one block. Rows of kBlockSize edges or fewer
+// have no skip entries at all.
+// Floating point weights can also be quantized to 8 or 16 bits, spread evenly between the
+// smallest and largest weight. Order within a row is kept, but weights read back rounded, so
+// find has to be given the rounded weight.
+// Edges can only be walked forwards, since gaps can only be decoded in that direction.
+template <typename N, typename E>
+class CompressedGraph {
+ public:
+  // Default constructor, an empty graph
+  CompressedGraph<N, E>() = default;
+
+  // weightBits = 0 keeps weights exact, 8 or 16 quantizes floating point weights
+  explicit CompressedGraph<N, E>(const CsrGraph<N, E>& g, unsigned weightBits = 0);
+
+  bool IsNode(const N& val) const;
+  bool IsConnected(const N& src, const N& dst) const;
+
+  std::vector<N> GetNodes() const { return nodes; }
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+
+  std::size_t NodeCount() const { return nodes.size(); }
+  std::size_t EdgeCount() const { return offsets.back(); }
+  // Returns NodeCount() if val isn't a node
+  std::size_t IndexOf(const N& val) const;
+  const N& ValueAt(std::size_t index) const { return nodes[index]; }
+  // Bytes held by every array, counting node values by sizeof(N) only
+  std::size_t Bytes() const;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    // The weight is decoded, so it comes out by value
+    using reference = std::tuple<const N&, const N&, E>;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+
+    //*, ++, == and !=
+    reference operator*() const;
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.graph_ == rhs.graph_ && lhs.at_.edge == rhs.at_.edge;
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    const CompressedGraph* graph_ = nullptr;
+    detail::RowCursor at_;
+
+    friend class CompressedGraph;
+    const_iterator(const CompressedGraph* graph, detail::RowCursor at)
+      : graph_{graph}, at_{at} {}
+  };
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_iterator find(const N& source, const N& dest, const E& weight) const;
+
+ private:
+  static constexpr std::size_t kBlockSize = 64;
+  // A skip entry is the destination and the row relative byte offset, 4 bytes each
+  static constexpr std::size_t kSkipBytes = 8;
+
+  using Position = detail::RowCursor;
+
+  // Sorted node values, a node's index is its position here
+  std::vector<N> nodes;
+  // NodeCount() + 1 entries, as in CsrGraph
+  std::vector<std::size_t> offsets{0};
+  // Byte where each row starts
+  std::vector<std::size_t> rowStart;
+  std::vector<std::uint8_t> bytes;
+
+  // Exact weights, or codes of weightBits bits each
+  std::vector<E> weights;
+  std::vector<std::uint8_t> codes;
+  unsigned weightBits = 0;
+  double weightMin = 0;
+  double weightStep = 0;
+
+  E weightAt(std::size_t edge) const;
+  std::size_t skipCount(std::size_t node) const {
+    return (offsets[node + 1] - offsets[node] - 1) / kBlockSize;
+  }
+  // First edge of node, which has to have edges
+  Position rowBegin(std::size_t node) const;
+  // Next edge in the same row, edge must not be its last
+  void next(Position& at) const;
+  // First edge of src going to dst or past it, edge is offsets[src + 1] if there's none
+  Position seek(std::size_t src, std::uint32_t dst) const;
+};
+
+}  // namespace gdwg
+#include "assignments/dg/compressed_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/dg/varint.h"
+
+template <typename N, typename E>
+gdwg::CompressedGraph<N, E>::CompressedGraph(const CsrGraph<N, E>& g, unsigned bits)
+  : nodes{g.GetNodes()}, offsets{g.Offsets()}, weightBits{bits} {
+  if (bits != 0 && bits != 8 && bits != 16) {
+    throw std::runtime_error("Cannot call CompressedGraph with weightBits other than 0, 8 or 16");
+  }
+  if (bits != 0 && !std::is_floating_point_v<E>) {
+    throw std::runtime_error(
+        "Cannot call CompressedGraph with weightBits if weights aren't floating point");
+  }
+
+  const auto& destinations = g.Destinations();
+  rowStart.reserve(nodes.size());
+  for (std::size_t u = 0; u < nodes.size(); ++u) {
+    rowStart.push_back(bytes.size());
+    if (offsets[u] == offsets[u + 1])
+      continue;
+    // Room for the skip entries, which are filled in as their blocks are reached
+    const auto table = bytes.size();
+    bytes.resize(table + skipCount(u) * kSkipBytes);
+    detail::PutVarint(bytes, detail::ZigZag(static_cast<std::int64_t>(destinations[offsets[u]]) -
+                                            static_cast<std::int64_t>(u)));
+    for (auto e = offsets[u] + 1; e < offsets[u + 1]; ++e) {
+      detail::PutVarint(bytes, destinations[e] - destinations[e - 1]);
+      auto i = e - offsets[u];
+      if (i % kBlockSize == 0) {
+        std::uint32_t entry[2] = {destinations[e],
+                                  static_cast<std::uint32_t>(bytes.size() - rowStart[u])};
+        std::memcpy(bytes.data() + table + (i / kBlockSize - 1) * kSkipBytes, entry, kSkipBytes);
+      }
+    }
+  }
+  bytes.shrink_to_fit();
+
+  if (bits == 0) {
+    weights = g.Weights();
+    return;
+  }
+  if constexpr (std::is_floating_point_v<E>) {
+    const auto& exact = g.Weights();
+    if (exact.empty())
+      return;
+    auto [lo, hi] = std::minmax_element(exact.begin(), exact.end());
+    weightMin = static_cast<double>(*lo);
+    weightStep = (static_cast<double>(*hi) - weightMin) / static_cast<double>((1u << bits) - 1);
+    codes.reserve(exact.size() * bits / 8);
+    for (const auto& w : exact) {
+      auto code = weightStep > 0 ? std::lround((static_cast<double>(w) - weightMin) / weightStep)
+                                 : 0;
+      codes.push_back(static_cast<std::uint8_t>(code));
+      if (bits == 16)
+        codes.push_back(static_cast<std::uint8_t>(code >> 8));
+    }
+  }
+}
+
+template <typename N, typename E>
+E gdwg::CompressedGraph<N, E>::weightAt(std::size_t edge) const {
+  if constexpr (std::is_floating_point_v<E>) {
+    if (weightBits == 8)
+      return static_cast<E>(weightMin + codes[edge] * weightStep);
+    if (weightBits == 16) {
+      auto code = codes[2 * edge] | (codes[2 * edge + 1] << 8);
+      return static_cast<E>(weightMin + code * weightStep);
+    }
+  }
+  return weights[edge];
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::Position
+gdwg::CompressedGraph<N, E>::rowBegin(std::size_t node) const {
+  Position at{node, offsets[node], 0, rowStart[node] + skipCount(node) * kSkipBytes};
+  auto gap = detail::UnZigZag(detail::GetVarint(bytes.data(), at.pos));
+  at.dest = static_cast<std::uint32_t>(static_cast<std::int64_t>(node) + gap);
+  return at;
+}
+
+template <typename N, typename E>
+void gdwg::CompressedGraph<N, E>::next(Position& at) const {
+  ++at.edge;
+  at.dest += static_cast<std::uint32_t>(detail::GetVarint(bytes.data(), at.pos));
+}
+
+// Binary search over the row's skip entries, then decodes the rest of the way
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::Position
+gdwg::CompressedGraph<N, E>::seek(std::size_t src, std::uint32_t dst) const {
+  const auto last = offsets[src + 1];
+  if (offsets[src] == last)
+    return Position{src, last, 0, 0};
+
+  const auto entry = [this, src](std::size_t k) {
+    std::uint32_t fields[2];
+    std::memcpy(fields, bytes.data() + rowStart[src] + k * kSkipBytes, kSkipBytes);
+    return std::make_pair(fields[0], fields[1]);
+  };
+  // First entry at dst or past it, the block before it is where dst would start
+  std::size_t lo = 0;
+  std::size_t hi = skipCount(src);
+  while (lo < hi) {
+    auto mid = (lo + hi) / 2;
+    if (entry(mid).first < dst) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  Position at;
+  if (lo == 0) {
+    at = rowBegin(src);
+  } else {
+    auto [dest, offset] = entry(lo - 1);
+    at = Position{src, offsets[src] + lo * kBlockSize, dest, rowStart[src] + offset};
+  }
+
+  while (at.dest < dst) {
+    if (at.edge + 1 == last)
+      return Position{src, last, 0, 0};
+    next(at);
+  }
+  return at;
+}
+
+template <typename N, typename E>
+std::size_t gdwg::CompressedGraph<N, E>::IndexOf(const N& val) const {
+  auto it = std::lower_bound(nodes.begin(), nodes.end(), val);
+  if (it == nodes.end() || val < *it)
+    return nodes.size();
+  return static_cast<std::size_t>(it - nodes.begin());
+}
+
+template <typename N, typename E>
+std::size_t gdwg::CompressedGraph<N, E>::Bytes() const {
+  return nodes.size() * sizeof(N) + offsets.size() * sizeof(std::size_t) +
+         rowStart.size() * sizeof(std::size_t) + bytes.size() + weights.size() * sizeof(E) +
+         codes.size();
+}
+
+// Checks if node exists
+template <typename N, typename E>
+bool gdwg::CompressedGraph<N, E>::IsNode(const N& val) const {
+  return IndexOf(val) != nodes.size();
+}
+
+// Checks if there is an edge from src to dst
+template <typename N, typename E>
+bool gdwg::CompressedGraph<N, E>::IsConnected(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodes.size() || d == nodes.size()) {
+    throw std::runtime_error(
+        "Cannot call CompressedGraph::IsConnected if src or dst node don't exist in the graph");
+  }
+  auto at = seek(s, static_cast<std::uint32_t>(d));
+  return at.edge != offsets[s + 1] && at.dest == d;
+}
+
+// Creates a vector containing the destination of every edge out of src
+template <typename N, typename E>
+std::vector<N> gdwg::CompressedGraph<N, E>::GetConnected(const N& src) const {
+  auto s = IndexOf(src);
+  if (s == nodes.size()) {
+    throw std::out_of_range(
+        "Cannot call CompressedGraph::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> ret;
+  if (offsets[s] == offsets[s + 1])
+    return ret;
+  ret.reserve(offsets[s + 1] - offsets[s]);
+  auto at = rowBegin(s);
+  ret.push_back(nodes[at.dest]);
+  while (at.edge + 1 < offsets[s + 1]) {
+    next(at);
+    ret.push_back(nodes[at.dest]);
+  }
+  return ret;
+}
+
+// Creates a vector containing all weights of edges from src to dst
+template <typename N, typename E>
+std::vector<E> gdwg::CompressedGraph<N, E>::GetWeights(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodes.size() || d == nodes.size()) {
+    throw std::out_of_range(
+        "Cannot call CompressedGraph::GetWeights if src or dst node don't exist in the graph");
+  }
+  std::vector<E> ret;
+  auto at = seek(s, static_cast<std::uint32_t>(d));
+  while (at.edge != offsets[s + 1] && at.dest == d) {
+    ret.push_back(weightAt(at.edge));
+    if (at.edge + 1 == offsets[s + 1])
+      break;
+    next(at);
+  }
+  return ret;
+}
+
+// Iterator related functions
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator gdwg::CompressedGraph<N, E>::begin() const {
+  // Skip leading nodes without any edges
+  std::size_t node = 0;
+  while (node < nodes.size() && offsets[node + 1] == 0)
+    ++node;
+  if (node == nodes.size())
+    return end();
+  return const_iterator{this, rowBegin(node)};
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator gdwg::CompressedGraph<N, E>::end() const {
+  return const_iterator{this, Position{nodes.size(), EdgeCount(), 0, 0}};
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator
+gdwg::CompressedGraph<N, E>::find(const N& source, const N& dest, const E& weight) const {
+  auto s = IndexOf(source);
+  auto d = IndexOf(dest);
+  if (s == nodes.size() || d == nodes.size())
+    return end();
+  auto at = seek(s, static_cast<std::uint32_t>(d));
+  // Weights to the same destination are sorted, so stop once past weight
+  while (at.edge != offsets[s + 1] && at.dest == d && !(weight < weightAt(at.edge))) {
+    if (weightAt(at.edge) == weight)
+      return const_iterator{this, at};
+    if (at.edge + 1 == offsets[s + 1])
+      break;
+    next(at);
+  }
+  return end();
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator::reference
+    gdwg::CompressedGraph<N, E>::const_iterator::operator*() const {
+  return {graph_->nodes[at_.node], graph_->nodes[at_.dest], graph_->weightAt(at_.edge)};
+}
+
+// Decodes the next gap, or moves on to the first edge of the next node that has any
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator&
+gdwg::CompressedGraph<N, E>::const_iterator::operator++() {
+  if (at_.edge + 1 < graph_->offsets[at_.node + 1]) {
+    graph_->next(at_);
+    return *this;
+  }
+  auto node = at_.node + 1;
+  while (node < graph_->nodes.size() && graph_->offsets[node] == graph_->offsets[node + 1])
+    ++node;
+  at_ = node == graph_->nodes.size() ? graph_->end().at_ : graph_->rowBegin(node);
+  return *this;
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::const_iterator
+gdwg::CompressedGraph<N, E>::const_iterator::operator++(int) {
+  auto copy{*this};
+  ++(*this);
+  return copy;
+}
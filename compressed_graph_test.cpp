@@ -0,0 +1,143 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  A small graph with string nodes is checked against its CsrGraph by hand:
+  nodes, connections, weights, iteration order, find and the exceptions.
+
+  A larger generated graph has a few hub rows long enough to need several
+  skip entries, with repeated destinations that straddle block boundaries.
+  Every edge is walked in both forms and compared, and every node's
+  connections and a spread of GetWeights calls have to match, which covers
+  seeks that land in the first block, a later block and past the row's end.
+
+  Quantized weights are checked to be within half a step of the originals,
+  still sorted, and the compressed form of a graph with local edges has to
+  take at most a third of the memory of the CsrGraph it came from.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/compressed_graph.h"
+#include "catch.h"
+
+namespace {
+
+template <typename N, typename E>
+std::size_t csrBytes(const gdwg::CsrGraph<N, E>& g) {
+  return g.NodeCount() * sizeof(N) + g.Offsets().size() * sizeof(std::size_t) +
+         g.Destinations().size() * sizeof(std::uint32_t) + g.Weights().size() * sizeof(E);
+}
+
+}  // namespace
+
+SCENARIO("Testing CompressedGraph on a small graph") {
+  GIVEN("A graph with a self loop, parallel edges and a node with no edges") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d"};
+    g.InsertEdge("a", "b", 3);
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("a", "d", 2);
+    g.InsertEdge("c", "a", 4);
+    g.InsertEdge("c", "c", 5);
+    auto csr = g.Freeze();
+    gdwg::CompressedGraph<std::string, int> compressed{csr};
+    THEN("It answers the same as the snapshot") {
+      REQUIRE(compressed.GetNodes() == csr.GetNodes());
+      REQUIRE(compressed.EdgeCount() == 5);
+      REQUIRE(compressed.GetConnected("a") == std::vector<std::string>{"b", "b", "d"});
+      REQUIRE(compressed.GetConnected("b").empty());
+      REQUIRE(compressed.GetWeights("a", "b") == std::vector<int>{1, 3});
+      REQUIRE(compressed.GetWeights("c", "c") == std::vector<int>{5});
+      REQUIRE(compressed.GetWeights("a", "c").empty());
+      REQUIRE(compressed.IsConnected("c", "a"));
+      REQUIRE(!compressed.IsConnected("d", "a"));
+    }
+    THEN("Iteration skips nodes without edges and keeps CsrGraph's order") {
+      std::vector<std::tuple<std::string, std::string, int>> walked;
+      for (const auto& [src, dst, w] : compressed) {
+        walked.emplace_back(src, dst, w);
+      }
+      REQUIRE(walked == std::vector<std::tuple<std::string, std::string, int>>(csr.begin(),
+                                                                                csr.end()));
+    }
+    THEN("find lands on the edge or end") {
+      auto it = compressed.find("a", "b", 3);
+      REQUIRE(it != compressed.end());
+      REQUIRE(std::get<2>(*it) == 3);
+      REQUIRE(std::get<1>(*++it) == "d");
+      REQUIRE(compressed.find("a", "b", 2) == compressed.end());
+      REQUIRE(compressed.find("z", "b", 3) == compressed.end());
+    }
+    THEN("Missing nodes and bad weight widths throw") {
+      REQUIRE_THROWS_AS(compressed.IsConnected("a", "z"), std::runtime_error);
+      REQUIRE_THROWS_AS(compressed.GetConnected("z"), std::out_of_range);
+      REQUIRE_THROWS_AS(compressed.GetWeights("z", "a"), std::out_of_range);
+      REQUIRE_THROWS_AS((gdwg::CompressedGraph<std::string, int>{csr, 8}), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Testing CompressedGraph on a larger graph") {
+  GIVEN("A generated graph with a few hub rows several blocks long") {
+    gdwg::Graph<int, double> g;
+    const int n = 3000;
+    for (int i = 0; i < n; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int k = 1; k <= 32; ++k) {
+        g.InsertEdge(i, (i + k * k) % n, k * 0.25);
+      }
+      // Hubs get every third node twice, so repeats cross block boundaries
+      if (i % 1000 == 0) {
+        for (int j = 0; j < n; j += 3) {
+          g.InsertEdge(i, j, 1.0);
+          g.InsertEdge(i, j, 2.0);
+        }
+      }
+    }
+    auto csr = g.Freeze();
+    WHEN("It is compressed with exact weights") {
+      gdwg::CompressedGraph<int, double> compressed{csr};
+      THEN("Every edge, row and weight list matches the snapshot") {
+        auto it = compressed.begin();
+        for (const auto& edge : csr) {
+          REQUIRE(it != compressed.end());
+          REQUIRE(*it == edge);
+          ++it;
+        }
+        REQUIRE(it == compressed.end());
+        for (int i = 0; i < n; ++i) {
+          REQUIRE(compressed.GetConnected(i) == csr.GetConnected(i));
+          for (int j : {0, i, (i + 1) % n, (i + 4) % n, (i * 7) % n, n - 1}) {
+            REQUIRE(compressed.GetWeights(i, j) == csr.GetWeights(i, j));
+            REQUIRE(compressed.IsConnected(i, j) == csr.IsConnected(i, j));
+          }
+        }
+        REQUIRE(compressed.find(2000, 2997, 2.0) != compressed.end());
+        REQUIRE(compressed.Bytes() < csrBytes(csr));
+      }
+    }
+    WHEN("It is compressed with 16 bit weights") {
+      gdwg::CompressedGraph<int, double> compressed{csr, 16};
+      THEN("Weights are close, in order, and the whole thing is a third of the size or less") {
+        const double step = (32 * 0.25 - 0.25) / 65535;
+        auto it = compressed.begin();
+        for (const auto& edge : csr) {
+          REQUIRE(std::get<1>(*it) == std::get<1>(edge));
+          REQUIRE(std::abs(std::get<2>(*it) - std::get<2>(edge)) <= step / 2 + 1e-12);
+          ++it;
+        }
+        auto weights = compressed.GetWeights(1000, 999);
+        REQUIRE(weights.size() == 2);
+        REQUIRE(weights[0] < weights[1]);
+        REQUIRE(compressed.Bytes() * 3 <= csrBytes(csr));
+      }
+    }
+  }
+}
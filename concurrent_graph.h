@@ -0,0 +1,119 @@
+#ifndef ASSIGNMENTS_DG_CONCURRENT_GRAPH_H_
+#define ASSIGNMENTS_DG_CONCURRENT_GRAPH_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+#include "assignments/dg/journal.h"
+
+namespace gdwg {
+
+// A graph that many threads can read while one thread at a time changes it.
+// Readers take a snapshot, which is immutable and stays valid for as long as they hold it,
+// and never wait on a writer or on each other. Writers apply a batch of mutations to the
+// graph in place under a mutex and then publish a new snapshot in one atomic step, so readers
+// see all of a batch or none of it.
+// Publishing is a pointer swap. Each reader marks the snapshot it holds in a slot of its own
+// (a hazard pointer), and a writer only frees replaced snapshots no slot marks, so reading
+// takes no lock and shares no reference count with other readers.
+template <typename N, typename E>
+class ConcurrentGraph {
+  struct Hazard;
+
+ public:
+  // A reader's hold on one published state. Snapshots can't outlive their ConcurrentGraph
+  class Snapshot {
+   public:
+    Snapshot(const Snapshot& other);
+    Snapshot(Snapshot&& other) noexcept
+      : owner{other.owner}, slot{other.slot}, graph{other.graph} {
+      other.slot = nullptr;
+      other.graph = nullptr;
+    }
+    Snapshot& operator=(Snapshot other) noexcept {
+      std::swap(owner, other.owner);
+      std::swap(slot, other.slot);
+      std::swap(graph, other.graph);
+      return *this;
+    }
+    ~Snapshot();
+
+    const CsrGraph<N, E>& operator*() const { return *graph; }
+    const CsrGraph<N, E>* operator->() const { return graph; }
+
+    // Whether both hold the same published state
+    friend bool operator==(const Snapshot& a, const Snapshot& b) { return a.graph == b.graph; }
+    friend bool operator!=(const Snapshot& a, const Snapshot& b) { return a.graph != b.graph; }
+
+   private:
+    friend class ConcurrentGraph;
+
+    const ConcurrentGraph* owner;
+    Hazard* slot;
+    const CsrGraph<N, E>* graph;
+
+    Snapshot(const ConcurrentGraph* o, Hazard* s, const CsrGraph<N, E>* g)
+      : owner{o}, slot{s}, graph{g} {}
+  };
+
+  // Default constructor, starts out empty
+  ConcurrentGraph<N, E>() : ConcurrentGraph<N, E>(Graph<N, E>{}) {}
+
+  // Starts out with the contents of an existing graph
+  explicit ConcurrentGraph<N, E>(Graph<N, E> initial);
+
+  ConcurrentGraph<N, E>(const ConcurrentGraph&) = delete;
+  ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+
+  // No snapshot can still be held
+  ~ConcurrentGraph<N, E>();
+
+  // The latest published state
+  Snapshot Read() const;
+
+  // Calls mutate(Graph<N, E>&) and publishes the result, returning whatever mutate returns.
+  // If mutate throws, nothing is published and the graph is put back as it was. That undoes
+  // the changes mutate made one by one, so mutate mustn't assign to the graph or record it.
+  // Each call freezes the whole graph, so mutations should be batched
+  template <typename F>
+  auto Update(F mutate) -> decltype(mutate(std::declval<Graph<N, E>&>()));
+
+  // Copy of the latest state as a mutable graph
+  Graph<N, E> Copy() const;
+
+ private:
+  // Changes can be undone through a MutationLog when it can hold N and E, otherwise a
+  // batch goes on a copy of the graph
+  static constexpr bool kUndoable = detail::kLoggable<N> && detail::kLoggable<E>;
+
+  // A reader's slot, taken by one snapshot at a time. Slots are only freed with the graph,
+  // so the list can be walked and pushed onto without a lock
+  struct Hazard {
+    std::atomic<const CsrGraph<N, E>*> protects{nullptr};
+    std::atomic<bool> taken{true};
+    Hazard* next = nullptr;
+  };
+
+  // Only touched with writeMutex held
+  Graph<N, E> working;
+  // Snapshots replaced since, that a reader might still hold
+  std::vector<const CsrGraph<N, E>*> retired;
+  mutable std::mutex writeMutex;
+  std::atomic<const CsrGraph<N, E>*> published;
+  mutable std::atomic<Hazard*> hazards{nullptr};
+
+  // A free slot, or a new one if they're all taken
+  Hazard* acquire() const;
+  // Swaps in frozen and frees the replaced snapshots no reader holds
+  void publish(std::unique_ptr<const CsrGraph<N, E>> frozen);
+};
+
+}  // namespace gdwg
+#include "assignments/dg/concurrent_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_CONCURRENT_GRAPH_H_
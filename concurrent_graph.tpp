@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::ConcurrentGraph<N, E>::ConcurrentGraph(Graph<N, E> initial)
+  : working{std::move(initial)}, published{new CsrGraph<N, E>{working}} {}
+
+template <typename N, typename E>
+gdwg::ConcurrentGraph<N, E>::~ConcurrentGraph() {
+  delete published.load();
+  for (const auto& graph : retired) {
+    delete graph;
+  }
+  for (auto slot = hazards.load(); slot != nullptr;) {
+    auto next = slot->next;
+    delete slot;
+    slot = next;
+  }
+}
+
+// Marks the published pointer in a slot, then checks it's still published. If it is, a
+// writer replacing it after that sees the mark and won't free it
+template <typename N, typename E>
+typename gdwg::ConcurrentGraph<N, E>::Snapshot gdwg::ConcurrentGraph<N, E>::Read() const {
+  auto slot = acquire();
+  auto graph = published.load();
+  for (;;) {
+    slot->protects.store(graph);
+    auto again = published.load();
+    if (again == graph)
+      break;
+    graph = again;
+  }
+  return Snapshot{this, slot, graph};
+}
+
+// Applies a batch of mutations and publishes it
+template <typename N, typename E>
+template <typename F>
+auto gdwg::ConcurrentGraph<N, E>::Update(F mutate)
+    -> decltype(mutate(std::declval<Graph<N, E>&>())) {
+  std::lock_guard<std::mutex> lock{writeMutex};
+  if constexpr (kUndoable) {
+    // Recorded so a throw part way through can be undone, at the cost of the batch
+    MutationLog<N, E> log;
+    working.Record(&log);
+    try {
+      if constexpr (std::is_void_v<decltype(mutate(working))>) {
+        mutate(working);
+        auto frozen = std::make_unique<const CsrGraph<N, E>>(working);
+        working.Record(nullptr);
+        publish(std::move(frozen));
+      } else {
+        auto result = mutate(working);
+        auto frozen = std::make_unique<const CsrGraph<N, E>>(working);
+        working.Record(nullptr);
+        publish(std::move(frozen));
+        return result;
+      }
+    } catch (...) {
+      log.Rollback(working, log.Begin());
+      working.Record(nullptr);
+      throw;
+    }
+  } else {
+    // Mutating a copy means a throw part way through leaves nothing half done
+    Graph<N, E> next{working};
+    if constexpr (std::is_void_v<decltype(mutate(next))>) {
+      mutate(next);
+      auto frozen = std::make_unique<const CsrGraph<N, E>>(next);
+      working = std::move(next);
+      publish(std::move(frozen));
+    } else {
+      auto result = mutate(next);
+      auto frozen = std::make_unique<const CsrGraph<N, E>>(next);
+      working = std::move(next);
+      publish(std::move(frozen));
+      return result;
+    }
+  }
+}
+
+template <typename N, typename E>
+gdwg::Graph<N, E> gdwg::ConcurrentGraph<N, E>::Copy() const {
+  std::lock_guard<std::mutex> lock{writeMutex};
+  return working;
+}
+
+template <typename N, typename E>
+typename gdwg::ConcurrentGraph<N, E>::Hazard* gdwg::ConcurrentGraph<N, E>::acquire() const {
+  for (auto slot = hazards.load(); slot != nullptr; slot = slot->next) {
+    bool taken = false;
+    if (!slot->taken.load(std::memory_order_relaxed) &&
+        slot->taken.compare_exchange_strong(taken, true))
+      return slot;
+  }
+  auto slot = new Hazard;
+  slot->next = hazards.load();
+  while (!hazards.compare_exchange_weak(slot->next, slot)) {
+  }
+  return slot;
+}
+
+// Called with writeMutex held
+template <typename N, typename E>
+void gdwg::ConcurrentGraph<N, E>::publish(std::unique_ptr<const CsrGraph<N, E>> frozen) {
+  retired.reserve(retired.size() + 1);
+  retired.push_back(published.exchange(frozen.release()));
+  // A reader that marked a retired snapshot before the exchange is seen here. One that marks
+  // it after sees it's no longer published, and moves on before using it
+  std::vector<const CsrGraph<N, E>*> held;
+  for (auto slot = hazards.load(); slot != nullptr; slot = slot->next) {
+    if (auto graph = slot->protects.load())
+      held.push_back(graph);
+  }
+  std::sort(held.begin(), held.end());
+  auto kept = std::partition(retired.begin(), retired.end(), [&held](const auto& graph) {
+    return std::binary_search(held.begin(), held.end(), graph);
+  });
+  for (auto it = kept; it != retired.end(); ++it) {
+    delete *it;
+  }
+  retired.erase(kept, retired.end());
+}
+
+template <typename N, typename E>
+gdwg::ConcurrentGraph<N, E>::Snapshot::Snapshot(const Snapshot& other)
+  : owner{other.owner}, slot{nullptr}, graph{other.graph} {
+  // other keeps graph alive while this marks it too
+  if (graph != nullptr) {
+    slot = owner->acquire();
+    slot->protects.store(graph);
+  }
+}
+
+template <typename N, typename E>
+gdwg::ConcurrentGraph<N, E>::Snapshot::~Snapshot() {
+  if (slot != nullptr) {
+    slot->protects.store(nullptr);
+    slot->taken.store(false);
+  }
+}
@@ -0,0 +1,129 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  A ConcurrentGraph is checked single threaded first: updates have to show up
+  in snapshots taken after them, snapshots taken before have to stay the same,
+  and an update that throws must not publish anything. Updates change the
+  graph in place, so a throw has to undo what the batch already did, for
+  graphs that can be recorded and for ones that can't. Snapshots held or
+  copied across many updates must stay readable while the ones nobody holds
+  are freed, which the address sanitizer would catch going wrong.
+
+  Then several reader threads take snapshots in a loop while a writer keeps
+  publishing batches. Every batch adds a node and an edge to it from the
+  previous node, so any snapshot a reader sees must be a complete chain. A
+  reader seeing part of a batch would find a node with no edge into it.
+*/
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "assignments/dg/concurrent_graph.h"
+#include "catch.h"
+
+SCENARIO("Testing ConcurrentGraph updates") {
+  GIVEN("A concurrent graph made from an existing graph") {
+    gdwg::Graph<char, int> g{'a', 'b'};
+    g.InsertEdge('a', 'b', 1);
+    gdwg::ConcurrentGraph<char, int> cg{g};
+    auto before = cg.Read();
+
+    WHEN("A batch of mutations is applied") {
+      bool res = cg.Update([](gdwg::Graph<char, int>& graph) {
+        graph.InsertNode('c');
+        graph.InsertEdge('b', 'c', 2);
+        return graph.DeleteNode('a');
+      });
+      THEN("New snapshots see all of it and the old snapshot is unchanged") {
+        REQUIRE(res);
+        auto after = cg.Read();
+        REQUIRE(after->GetNodes() == std::vector<char>{'b', 'c'});
+        REQUIRE(after->IsConnected('b', 'c'));
+        REQUIRE(*before == g.Freeze());
+        REQUIRE(cg.Copy().Freeze() == *after);
+      }
+    }
+    WHEN("A batch throws part way through") {
+      REQUIRE_THROWS_AS(cg.Update([](gdwg::Graph<char, int>& graph) {
+        graph.InsertNode('c');
+        graph.InsertEdge('a', 'z', 3);
+      }),
+                        std::runtime_error);
+      THEN("Nothing from it is published or kept") {
+        REQUIRE(cg.Read() == before);
+        REQUIRE(!cg.Copy().IsNode('c'));
+        REQUIRE(cg.Copy().IsConnected('a', 'b'));
+      }
+    }
+    WHEN("Snapshots are held and copied across many updates") {
+      auto copy = before;
+      for (int i = 0; i < 100; ++i) {
+        cg.Update([](gdwg::Graph<char, int>& graph) { graph.InsertEdge('b', 'a', 1); });
+        cg.Update([](gdwg::Graph<char, int>& graph) { graph.erase('b', 'a', 1); });
+      }
+      auto later = cg.Read();
+      THEN("They still read the state they were taken at") {
+        REQUIRE(copy == before);
+        REQUIRE(*copy == g.Freeze());
+        REQUIRE(later != before);
+        REQUIRE(*later == g.Freeze());
+      }
+    }
+  }
+  GIVEN("A concurrent graph whose weights can't be recorded") {
+    gdwg::Graph<char, std::vector<int>> g{'a', 'b'};
+    g.InsertEdge('a', 'b', {1});
+    gdwg::ConcurrentGraph<char, std::vector<int>> cg{g};
+    WHEN("A batch throws part way through") {
+      REQUIRE_THROWS_AS(cg.Update([](gdwg::Graph<char, std::vector<int>>& graph) {
+        graph.DeleteNode('a');
+        graph.InsertEdge('b', 'z', {2});
+      }),
+                        std::runtime_error);
+      THEN("The graph is left as it was") {
+        bool unchanged = cg.Copy() == g;
+        REQUIRE(unchanged);
+      }
+    }
+  }
+}
+
+SCENARIO("Testing ConcurrentGraph with readers and a writer") {
+  GIVEN("A graph that a writer grows into a chain") {
+    gdwg::ConcurrentGraph<int, int> cg{gdwg::Graph<int, int>{0}};
+    std::atomic<bool> done{false};
+    std::atomic<int> broken{0};
+
+    WHEN("Readers take snapshots while the writer publishes") {
+      std::vector<std::thread> readers;
+      for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&cg, &done, &broken] {
+          while (!done.load()) {
+            auto snapshot = cg.Read();
+            auto n = static_cast<int>(snapshot->NodeCount());
+            if (snapshot->EdgeCount() + 1 != snapshot->NodeCount() ||
+                (n > 1 && !snapshot->IsConnected(n - 2, n - 1)))
+              ++broken;
+          }
+        });
+      }
+      for (int i = 1; i <= 200; ++i) {
+        cg.Update([i](gdwg::Graph<int, int>& graph) {
+          graph.InsertNode(i);
+          graph.InsertEdge(i - 1, i, i);
+        });
+      }
+      done = true;
+      for (auto& reader : readers) {
+        reader.join();
+      }
+      THEN("No reader ever saw half a batch") {
+        REQUIRE(broken == 0);
+        REQUIRE(cg.Read()->NodeCount() == 201);
+      }
+    }
+  }
+}
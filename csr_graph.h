@@ -0,0 +1,127 @@
+#ifndef ASSIGNMENTS_DG_CSR_GRAPH_H_
+#define ASSIGNMENTS_DG_CSR_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+// Read-only snapshot of a Graph in compressed sparse row form.
+// Nodes are numbered densely in sorted order, and the out-edges of node i live in
+// [offsets[i], offsets[i + 1]) of the destination/weight arrays, sorted by destination
+// then weight, so traversal order is the same as Graph's const_iterator.
+template <typename N, typename E>
+class CsrGraph {
+ public:
+  // Default constructor, an empty snapshot
+  CsrGraph<N, E>() = default;
+
+  // Compacts an existing graph, whatever its instrumentation policy
+  template <typename I>
+  explicit CsrGraph<N, E>(const Graph<N, E, I>& g);
+
+  bool IsNode(const N& val) const;
+  bool IsConnected(const N& src, const N& dst) const;
+
+  std::vector<N> GetNodes() const;
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+
+  // Dense layout accessors, for algorithms that work on node indices directly
+  std::size_t NodeCount() const { return nodes.size(); }
+  std::size_t EdgeCount() const { return destinations.size(); }
+  // Returns NodeCount() if val isn't a node
+  std::size_t IndexOf(const N& val) const;
+  const N& ValueAt(std::size_t index) const { return nodes[index]; }
+  const std::vector<std::size_t>& Offsets() const { return offsets; }
+  const std::vector<std::uint32_t>& Destinations() const { return destinations; }
+  const std::vector<E>& Weights() const { return weights; }
+
+  // Same nodes with every edge reversed, rows stay sorted the same way
+  CsrGraph<N, E> Transpose() const;
+
+  friend std::ostream& operator<<(std::ostream& os, const gdwg::CsrGraph<N, E>& g) {
+    for (std::size_t i = 0; i < g.nodes.size(); ++i) {
+      os << g.nodes[i] << " (" << std::endl;
+      for (auto e = g.offsets[i]; e < g.offsets[i + 1]; ++e) {
+        os << "  " << g.nodes[g.destinations[e]] << " | " << g.weights[e] << std::endl;
+      }
+      os << ")" << std::endl;
+    }
+    return os;
+  }
+  friend bool operator==(const gdwg::CsrGraph<N, E>& a, const gdwg::CsrGraph<N, E>& b) {
+    return a.nodes == b.nodes && a.offsets == b.offsets && a.destinations == b.destinations &&
+           a.weights == b.weights;
+  }
+  friend bool operator!=(const gdwg::CsrGraph<N, E>& a, const gdwg::CsrGraph<N, E>& b) {
+    return !(a == b);
+  }
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    using reference = std::tuple<const N&, const N&, const E&>;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+
+    //*, ++, --, == and !=
+    reference operator*() const;
+    const_iterator& operator++();
+    const_iterator operator++(int);
+    const_iterator& operator--();
+    const_iterator operator--(int);
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.graph_ == rhs.graph_ && lhs.edge_ == rhs.edge_;
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    const CsrGraph* graph_ = nullptr;
+    std::size_t node_ = 0;  // source of the current edge, NodeCount() at end
+    std::size_t edge_ = 0;  // index into destinations/weights
+
+    friend class CsrGraph;
+    const_iterator(const CsrGraph* graph, std::size_t node, std::size_t edge)
+      : graph_{graph}, node_{node}, edge_{edge} {}
+  };
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+  const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+  const_iterator find(const N& source, const N& dest, const E& weight) const;
+
+ private:
+  // Sorted node values, a node's index is its position here
+  std::vector<N> nodes;
+  // NodeCount() + 1 entries
+  std::vector<std::size_t> offsets{0};
+  std::vector<std::uint32_t> destinations;
+  std::vector<E> weights;
+
+  // Range of src's edges going to dst
+  std::pair<std::size_t, std::size_t> edgeRange(std::size_t src, std::size_t dst) const;
+};
+
+}  // namespace gdwg
+#include "assignments/dg/csr_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_CSR_GRAPH_H_
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Compacts an existing graph
+template <typename N, typename E>
+template <typename I>
+gdwg::CsrGraph<N, E>::CsrGraph(const Graph<N, E, I>& g) {
+  // nodegraph is ordered, so numbering nodes in map order gives sorted indices
+  std::vector<std::uint32_t> index(g.IdBound());
+  nodes.reserve(g.nodegraph.size());
+  for (const auto& [key, val] : g.nodegraph) {
+    index[val->getId()] = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(key);
+  }
+
+  offsets.reserve(nodes.size() + 1);
+  for (const auto& [key, val] : g.nodegraph) {
+    // Out-edges are already sorted by destination, and indices follow node order
+    for (std::size_t i = 0; i < val->degree(); ++i) {
+      destinations.push_back(index[g.destNode(val, i)->getId()]);
+      weights.push_back(val->weightAt(i));
+    }
+    offsets.push_back(destinations.size());
+    (void)key;
+  }
+}
+
+// Freezes the graph into a read-only snapshot
+template <typename N, typename E, typename I>
+gdwg::CsrGraph<N, E> gdwg::Graph<N, E, I>::Freeze() const {
+  return CsrGraph<N, E>{*this};
+}
+
+// Counting sort on destination, visiting sources in order keeps every new row sorted
+template <typename N, typename E>
+gdwg::CsrGraph<N, E> gdwg::CsrGraph<N, E>::Transpose() const {
+  CsrGraph<N, E> t;
+  t.nodes = nodes;
+  t.offsets.assign(nodes.size() + 1, 0);
+  for (const auto& dst : destinations) {
+    ++t.offsets[dst + 1];
+  }
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    t.offsets[i + 1] += t.offsets[i];
+  }
+
+  t.destinations.resize(destinations.size());
+  t.weights.reserve(weights.size());
+  std::vector<std::size_t> next(t.offsets.begin(), t.offsets.end() - 1);
+  std::vector<std::size_t> order(destinations.size());
+  for (std::size_t src = 0; src < nodes.size(); ++src) {
+    for (auto e = offsets[src]; e < offsets[src + 1]; ++e) {
+      auto at = next[destinations[e]]++;
+      t.destinations[at] = static_cast<std::uint32_t>(src);
+      order[at] = e;
+    }
+  }
+  for (const auto& e : order) {
+    t.weights.push_back(weights[e]);
+  }
+  return t;
+}
+
+template <typename N, typename E>
+std::size_t gdwg::CsrGraph<N, E>::IndexOf(const N& val) const {
+  auto it = std::lower_bound(nodes.begin(), nodes.end(), val);
+  if (it == nodes.end() || val < *it)
+    return nodes.size();
+  return static_cast<std::size_t>(it - nodes.begin());
+}
+
+template <typename N, typename E>
+std::pair<std::size_t, std::size_t> gdwg::CsrGraph<N, E>::edgeRange(std::size_t src,
+                                                                   std::size_t dst) const {
+  auto first = destinations.begin() + offsets[src];
+  auto last = destinations.begin() + offsets[src + 1];
+  auto [lo, hi] = std::equal_range(first, last, static_cast<std::uint32_t>(dst));
+  return {static_cast<std::size_t>(lo - destinations.begin()),
+          static_cast<std::size_t>(hi - destinations.begin())};
+}
+
+// Checks if node exists
+template <typename N, typename E>
+bool gdwg::CsrGraph<N, E>::IsNode(const N& val) const {
+  return IndexOf(val) != nodes.size();
+}
+
+// Checks if there is an edge from src to dst
+template <typename N, typename E>
+bool gdwg::CsrGraph<N, E>::IsConnected(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodes.size() || d == nodes.size()) {
+    throw std::runtime_error(
+        "Cannot call CsrGraph::IsConnected if src or dst node don't exist in the graph");
+  }
+  auto [lo, hi] = edgeRange(s, d);
+  return lo != hi;
+}
+
+// Creates a vector containing all nodes in the snapshot
+template <typename N, typename E>
+std::vector<N> gdwg::CsrGraph<N, E>::GetNodes() const {
+  return nodes;
+}
+
+// Creates a vector containing the destination of every edge out of src
+template <typename N, typename E>
+std::vector<N> gdwg::CsrGraph<N, E>::GetConnected(const N& src) const {
+  auto s = IndexOf(src);
+  if (s == nodes.size()) {
+    throw std::out_of_range("Cannot call CsrGraph::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> ret;
+  ret.reserve(offsets[s + 1] - offsets[s]);
+  for (auto e = offsets[s]; e < offsets[s + 1]; ++e) {
+    ret.push_back(nodes[destinations[e]]);
+  }
+  return ret;
+}
+
+// Creates a vector containing all weights of edges from src to dst
+template <typename N, typename E>
+std::vector<E> gdwg::CsrGraph<N, E>::GetWeights(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodes.size() || d == nodes.size()) {
+    throw std::out_of_range(
+        "Cannot call CsrGraph::GetWeights if src or dst node don't exist in the graph");
+  }
+  auto [lo, hi] = edgeRange(s, d);
+  return std::vector<E>(weights.begin() + lo, weights.begin() + hi);
+}
+
+// Iterator related functions
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator gdwg::CsrGraph<N, E>::begin() const {
+  // Skip leading nodes without any edges
+  std::size_t node = 0;
+  while (node < nodes.size() && offsets[node + 1] == 0)
+    ++node;
+  return const_iterator{this, node, 0};
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator gdwg::CsrGraph<N, E>::end() const {
+  return const_iterator{this, nodes.size(), destinations.size()};
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator
+gdwg::CsrGraph<N, E>::find(const N& source, const N& dest, const E& weight) const {
+  auto s = IndexOf(source);
+  auto d = IndexOf(dest);
+  if (s == nodes.size() || d == nodes.size())
+    return end();
+  auto [lo, hi] = edgeRange(s, d);
+  auto it = std::lower_bound(weights.begin() + lo, weights.begin() + hi, weight);
+  if (it == weights.begin() + hi || weight < *it)
+    return end();
+  return const_iterator{this, s, static_cast<std::size_t>(it - weights.begin())};
+}
+
+//*, ++, --, == and !=
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator::reference gdwg::CsrGraph<N, E>::const_iterator::
+operator*() const {
+  return {graph_->nodes[node_], graph_->nodes[graph_->destinations[edge_]],
+          graph_->weights[edge_]};
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator& gdwg::CsrGraph<N, E>::const_iterator::
+operator++() {
+  ++edge_;
+  while (node_ < graph_->nodes.size() && graph_->offsets[node_ + 1] <= edge_)
+    ++node_;
+  return *this;
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator gdwg::CsrGraph<N, E>::const_iterator::
+operator++(int) {
+  auto copy{*this};
+  ++(*this);
+  return copy;
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator& gdwg::CsrGraph<N, E>::const_iterator::
+operator--() {
+  --edge_;
+  while (graph_->offsets[node_] > edge_)
+    --node_;
+  return *this;
+}
+
+template <typename N, typename E>
+typename gdwg::CsrGraph<N, E>::const_iterator gdwg::CsrGraph<N, E>::const_iterator::
+operator--(int) {
+  auto copy{*this};
+  --(*this);
+  return copy;
+}
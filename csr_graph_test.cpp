@@ -0,0 +1,131 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  A CsrGraph is only ever built from a Graph, so every scenario builds a small
+  Graph, freezes it and checks that the snapshot answers the read API exactly
+  the way the original graph does.
+
+  Traversal is tested by walking the snapshot forwards and backwards and
+  comparing against the order the Graph const_iterator gives, which is
+  source->dest->weight.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+#include "catch.h"
+
+SCENARIO("Testing CsrGraph construction") {
+  GIVEN("An empty graph") {
+    gdwg::Graph<std::string, int> g;
+    WHEN("It is frozen") {
+      auto csr = g.Freeze();
+      THEN("The snapshot has no nodes and begin() is end()") {
+        REQUIRE(csr.NodeCount() == 0);
+        REQUIRE(csr.EdgeCount() == 0);
+        REQUIRE(csr.begin() == csr.end());
+        REQUIRE(csr.rbegin() == csr.rend());
+      }
+    }
+  }
+  GIVEN("A graph with nodes but no edges") {
+    gdwg::Graph<char, std::string> g{'a', 'b', 'x', 'y'};
+    WHEN("It is frozen") {
+      gdwg::CsrGraph<char, std::string> csr{g};
+      THEN("All nodes are kept in sorted order") {
+        REQUIRE(csr.GetNodes() == g.GetNodes());
+        REQUIRE(csr.IsNode('x'));
+        REQUIRE(!csr.IsNode('z'));
+        REQUIRE(csr.begin() == csr.end());
+      }
+    }
+  }
+}
+
+SCENARIO("Testing CsrGraph read API") {
+  GIVEN("A frozen graph with 4 nodes and 6 edges") {
+    gdwg::Graph<std::string, int> g{"hello", "how", "are", "you?"};
+    g.InsertEdge("hello", "how", 5);
+    g.InsertEdge("hello", "are", 8);
+    g.InsertEdge("hello", "are", 2);
+    g.InsertEdge("how", "you?", 1);
+    g.InsertEdge("how", "hello", 4);
+    g.InsertEdge("are", "you?", 3);
+    auto csr = g.Freeze();
+
+    WHEN("Nodes and edges are queried") {
+      THEN("The answers match the original graph") {
+        REQUIRE(csr.NodeCount() == 4);
+        REQUIRE(csr.EdgeCount() == 6);
+        REQUIRE(csr.GetNodes() == g.GetNodes());
+        REQUIRE(csr.GetConnected("hello") == g.GetConnected("hello"));
+        REQUIRE(csr.GetWeights("hello", "are") == std::vector<int>{2, 8});
+        REQUIRE(csr.GetWeights("you?", "are").empty());
+        REQUIRE(csr.IsConnected("how", "hello"));
+        REQUIRE(!csr.IsConnected("hello", "you?"));
+      }
+    }
+    WHEN("Missing nodes are queried") {
+      THEN("The same exceptions as Graph are thrown") {
+        REQUIRE_THROWS_AS(csr.IsConnected("hello", "bye"), std::runtime_error);
+        REQUIRE_THROWS_AS(csr.GetConnected("bye"), std::out_of_range);
+        REQUIRE_THROWS_AS(csr.GetWeights("bye", "hello"), std::out_of_range);
+      }
+    }
+    WHEN("The snapshot is looped over with const_iterator") {
+      THEN("Edges come out in the same order as the graph's iterator") {
+        auto git = g.begin();
+        auto it = csr.begin();
+        for (; it != csr.end(); ++it, ++git) {
+          REQUIRE(*it == *git);
+        }
+        REQUIRE(git == g.end());
+      }
+    }
+    WHEN("The snapshot is looped over with const_reverse_iterator") {
+      THEN("Edges come out in reverse order") {
+        auto it = csr.rbegin();
+        REQUIRE(*it == std::make_tuple("how", "you?", 1));
+        for (int i = 0; i < 5; ++i)
+          ++it;
+        REQUIRE(*it == std::make_tuple("are", "you?", 3));
+        REQUIRE(++it == csr.rend());
+      }
+    }
+    WHEN("find() is used") {
+      THEN("Existing edges are found and missing ones return end()") {
+        REQUIRE(*csr.find("hello", "are", 8) == std::make_tuple("hello", "are", 8));
+        auto it = csr.find("hello", "how", 5);
+        REQUIRE(*--it == std::make_tuple("hello", "are", 8));
+        REQUIRE(csr.find("hello", "are", 3) == csr.end());
+        REQUIRE(csr.find("please", "goodMarks", 2) == csr.end());
+      }
+    }
+    WHEN("The snapshot is compared and printed") {
+      std::ostringstream a;
+      std::ostringstream b;
+      a << g;
+      b << csr;
+      THEN("It equals a second snapshot and prints like the graph") {
+        REQUIRE(csr == g.Freeze());
+        REQUIRE(a.str() == b.str());
+      }
+    }
+    WHEN("The snapshot is transposed") {
+      auto t = csr.Transpose();
+      THEN("Every edge is reversed and transposing twice gives the snapshot back") {
+        REQUIRE(t.EdgeCount() == 6);
+        REQUIRE(t.GetConnected("are") == std::vector<std::string>{"hello", "hello"});
+        REQUIRE(t.GetWeights("are", "hello") == std::vector<int>{2, 8});
+        REQUIRE(t.GetConnected("you?") == std::vector<std::string>{"are", "how"});
+        REQUIRE(t.Transpose() == csr);
+      }
+    }
+  }
+}
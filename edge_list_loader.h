@@ -0,0 +1,60 @@
+#ifndef ASSIGNMENTS_DG_EDGE_LIST_LOADER_H_
+#define ASSIGNMENTS_DG_EDGE_LIST_LOADER_H_
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/parallel.h"
+
+namespace gdwg {
+
+// What a call to LoadEdgeList did
+struct EdgeListStats {
+  std::size_t bytes = 0;
+  std::size_t lines = 0;
+  // Lines that weren't blank or a # comment but didn't parse as "src dst weight"
+  std::size_t badLines = 0;
+  // Edges that weren't already in the graph
+  std::size_t inserted = 0;
+  double seconds = 0;
+
+  double MegabytesPerSecond() const { return seconds > 0 ? bytes / seconds / 1e6 : 0; }
+};
+
+namespace detail {
+
+// Parses one whitespace separated field, returning false if it isn't a valid T.
+// Numbers use std::from_chars, strings are copied as is, anything else goes through operator>>
+template <typename T>
+bool parseField(std::string_view field, T& out);
+
+}  // namespace detail
+
+// Adds every "src dst weight" line of in to g.
+// The input is read in chunks of about chunkBytes, each batch of chunks is parsed on up to
+// threads threads (0 for one per core) and then merged in with InsertEdges, so memory stays
+// around threads * chunkBytes no matter how big the input is. The threads are started once
+// per call and kept for every batch.
+// Fields are separated by spaces or tabs, and blank lines and lines starting with # are skipped
+template <typename N, typename E, typename I>
+EdgeListStats LoadEdgeList(std::istream& in,
+                           Graph<N, E, I>& g,
+                           unsigned threads = 0,
+                           std::size_t chunkBytes = 1 << 22);
+
+// Same as above, reading from a file
+template <typename N, typename E, typename I>
+EdgeListStats LoadEdgeList(const std::string& path,
+                           Graph<N, E, I>& g,
+                           unsigned threads = 0,
+                           std::size_t chunkBytes = 1 << 22);
+
+}  // namespace gdwg
+#include "assignments/dg/edge_list_loader.tpp"
+
+#endif  // ASSIGNMENTS_DG_EDGE_LIST_LOADER_H_
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace gdwg {
+
+namespace detail {
+
+template <typename T>
+bool parseField(std::string_view field, T& out) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    out.assign(field.data(), field.size());
+    return true;
+  } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    // from_chars doesn't take a leading +, and removing it mustn't let +-5 through as -5
+    if (field.size() > 1 && field.front() == '+') {
+      field.remove_prefix(1);
+      if (field.front() == '-' || field.front() == '+')
+        return false;
+    }
+    auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), out);
+    return error == std::errc{} && end == field.data() + field.size();
+  } else {
+    std::istringstream is{std::string{field}};
+    return static_cast<bool>(is >> out) && (is >> std::ws).eof();
+  }
+}
+
+// Edges parsed out of one chunk
+template <typename N, typename E>
+struct ParsedChunk {
+  std::vector<std::tuple<N, N, E>> edges;
+  std::size_t lines = 0;
+  std::size_t badLines = 0;
+};
+
+// Parses every whole line in text
+template <typename N, typename E>
+void parseChunk(std::string_view text, ParsedChunk<N, E>& parsed) {
+  parsed.edges.clear();
+  parsed.lines = 0;
+  parsed.badLines = 0;
+  const auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+  while (!text.empty()) {
+    auto newline = text.find('\n');
+    auto line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    ++parsed.lines;
+
+    // Split into at most 4 fields, a 4th one means the line is bad
+    std::string_view fields[4];
+    std::size_t count = 0;
+    std::size_t i = 0;
+    while (count < 4) {
+      while (i < line.size() && isSpace(line[i]))
+        ++i;
+      if (i == line.size())
+        break;
+      auto start = i;
+      while (i < line.size() && !isSpace(line[i]))
+        ++i;
+      fields[count++] = line.substr(start, i - start);
+    }
+    if (count == 0 || fields[0].front() == '#')
+      continue;
+
+    N src;
+    N dst;
+    E w;
+    if (count == 3 && parseField(fields[0], src) && parseField(fields[1], dst) &&
+        parseField(fields[2], w)) {
+      parsed.edges.emplace_back(std::move(src), std::move(dst), std::move(w));
+    } else {
+      ++parsed.badLines;
+    }
+  }
+}
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+template <typename N, typename E, typename I>
+gdwg::EdgeListStats gdwg::LoadEdgeList(std::istream& in,
+                                       Graph<N, E, I>& g,
+                                       unsigned threads,
+                                       std::size_t chunkBytes) {
+  const auto start = std::chrono::steady_clock::now();
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  chunkBytes = std::max<std::size_t>(chunkBytes, 1);
+
+  EdgeListStats stats;
+  std::vector<std::string> chunks(threads);
+  std::vector<detail::ParsedChunk<N, E>> parsed(threads);
+  // Part of a line left over from the end of the last chunk
+  std::string carry;
+  detail::WorkerPool pool{threads};
+
+  while (in || !carry.empty()) {
+    // Read up to one chunk per thread, each ending on a line break
+    std::size_t filled = 0;
+    for (; filled < threads && (in || !carry.empty()); ++filled) {
+      auto& chunk = chunks[filled];
+      chunk.swap(carry);
+      carry.clear();
+      std::size_t newline = std::string::npos;
+      while (in && newline == std::string::npos) {
+        auto old = chunk.size();
+        chunk.resize(old + chunkBytes);
+        in.read(chunk.data() + old, static_cast<std::streamsize>(chunkBytes));
+        chunk.resize(old + static_cast<std::size_t>(in.gcount()));
+        stats.bytes += static_cast<std::size_t>(in.gcount());
+        newline = chunk.rfind('\n');
+      }
+      if (in && newline != std::string::npos) {
+        carry.assign(chunk, newline + 1);
+        chunk.resize(newline + 1);
+      }
+    }
+
+    pool.For(filled, 1, [&chunks, &parsed](std::size_t first, std::size_t last, unsigned) {
+      for (auto c = first; c < last; ++c) {
+        detail::parseChunk<N, E>(chunks[c], parsed[c]);
+      }
+    });
+
+    // Merged in file order, so the result doesn't depend on how the input was split
+    for (std::size_t c = 0; c < filled; ++c) {
+      stats.lines += parsed[c].lines;
+      stats.badLines += parsed[c].badLines;
+      stats.inserted += g.InsertEdges(parsed[c].edges);
+    }
+  }
+
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
+
+template <typename N, typename E, typename I>
+gdwg::EdgeListStats gdwg::LoadEdgeList(const std::string& path,
+                                       Graph<N, E, I>& g,
+                                       unsigned threads,
+                                       std::size_t chunkBytes) {
+  std::ifstream in{path, std::ios::binary};
+  if (!in) {
+    throw std::runtime_error("Cannot call LoadEdgeList on a file that can't be opened");
+  }
+  return LoadEdgeList(in, g, threads, chunkBytes);
+}
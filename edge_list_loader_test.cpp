@@ -0,0 +1,104 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Small inputs are loaded from string streams, so every kind of line can be
+  tested without touching the file system: good lines, duplicates, comments,
+  blank lines, lines with the wrong number of fields or values that don't
+  parse (including a sign after a leading +), Windows line endings and a last line with no line break.
+
+  To check that splitting the input doesn't change the result, a larger input
+  is loaded with tiny chunks on several threads and compared against loading
+  it in one piece on one thread.
+  The same input is also loaded into a graph with the counting policy, which
+  shows every batch going through InsertEdges.
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "assignments/dg/edge_list_loader.h"
+#include "catch.h"
+
+SCENARIO("Testing LoadEdgeList parsing") {
+  GIVEN("An input with good lines, bad lines and comments") {
+    std::istringstream in{"# src dst weight\n"
+                          "1 2 0.5\n"
+                          "1\t3   +2\r\n"
+                          "\n"
+                          "1 2 0.5\n"
+                          "2 3\n"
+                          "2 x 1\n"
+                          "2 3 1 4\n"
+                          "2 1 +-5\n"
+                          "3 2 ++5\n"
+                          "3 1 -1e3"};
+    gdwg::Graph<int, double> g;
+    WHEN("It is loaded") {
+      auto stats = gdwg::LoadEdgeList(in, g, 2, 8);
+      THEN("Good lines are added once and bad ones are counted") {
+        REQUIRE(stats.lines == 11);
+        REQUIRE(stats.badLines == 5);
+        REQUIRE(stats.inserted == 3);
+        REQUIRE(stats.bytes == in.str().size());
+        REQUIRE(g.GetNodes() == std::vector<int>{1, 2, 3});
+        REQUIRE(g.GetWeights(1, 3) == std::vector<double>{2});
+        REQUIRE(g.GetWeights(3, 1) == std::vector<double>{-1000});
+      }
+    }
+  }
+  GIVEN("An input with string nodes and weights") {
+    std::istringstream in{"sydney melbourne M31\nmelbourne sydney M31\n"};
+    gdwg::Graph<std::string, std::string> g{"canberra"};
+    WHEN("It is loaded into a graph that already has nodes") {
+      auto stats = gdwg::LoadEdgeList(in, g, 1);
+      THEN("The new edges are added alongside the existing nodes") {
+        REQUIRE(stats.inserted == 2);
+        REQUIRE(g.IsConnected("sydney", "melbourne"));
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"canberra", "melbourne", "sydney"});
+      }
+    }
+  }
+  GIVEN("A path that doesn't exist") {
+    gdwg::Graph<int, int> g;
+    THEN("An exception is thrown") {
+      REQUIRE_THROWS_AS(gdwg::LoadEdgeList("no/such/edges.txt", g), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Testing LoadEdgeList chunking") {
+  GIVEN("A few thousand lines of input") {
+    std::ostringstream text;
+    for (int i = 0; i < 5000; ++i) {
+      text << i % 300 << ' ' << (i * 7) % 300 << ' ' << i % 11 << '\n';
+    }
+    WHEN("It is loaded whole on one thread and in small chunks on four") {
+      gdwg::Graph<int, int> whole;
+      gdwg::Graph<int, int> split;
+      std::istringstream a{text.str()};
+      std::istringstream b{text.str()};
+      auto wholeStats = gdwg::LoadEdgeList(a, whole, 1, 1 << 20);
+      auto splitStats = gdwg::LoadEdgeList(b, split, 4, 64);
+      THEN("Both give the same graph") {
+        REQUIRE(whole == split);
+        REQUIRE(wholeStats.lines == 5000);
+        REQUIRE(splitStats.lines == 5000);
+        REQUIRE(splitStats.inserted == wholeStats.inserted);
+        REQUIRE(splitStats.badLines == 0);
+      }
+    }
+    WHEN("It is loaded into a graph that counts its operations") {
+      gdwg::Graph<int, int, gdwg::CountingInstrumentation> counted;
+      std::istringstream a{text.str()};
+      auto stats = gdwg::LoadEdgeList(a, counted, 4, 64);
+      THEN("Every batch goes through InsertEdges, which creates the nodes too") {
+        REQUIRE(stats.lines == 5000);
+        REQUIRE(counted.Stats()[gdwg::GraphOp::kInsertEdges].calls > 1);
+        REQUIRE(counted.Stats()[gdwg::GraphOp::kInsertEdges].allocations ==
+                stats.inserted + counted.GetNodes().size());
+      }
+    }
+  }
+}
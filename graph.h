@@ -2,170 +2,567 @@
 #define ASSIGNMENTS_DG_GRAPH_H_
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "assignments/dg/instrumentation.h"
+#include "assignments/dg/intern_table.h"
+#include "assignments/dg/journal.h"
+#include "assignments/dg/pool.h"
+#include "assignments/dg/reachability.h"
+
 namespace gdwg {
 
+namespace detail {
+
+// splitmix64 finaliser, spreads a std::hash result over all 64 bits
+inline std::uint64_t Mix(std::uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Stands in for a member one layout doesn't use
+struct Unused {};
+
+// First i in [first, last) where pred(i) is false, pred being true for a prefix of the range.
+// A binary search over positions, for lists kept in more than one array
+template <typename Pred>
+std::size_t PartitionPoint(std::size_t first, std::size_t last, Pred pred) {
+  while (first < last) {
+    auto mid = first + (last - first) / 2;
+    if (pred(mid)) {
+      first = mid + 1;
+    } else {
+      last = mid;
+    }
+  }
+  return first;
+}
+
+// Whether Graph<N, E> packs each node's out-edges into two flat arrays, destination values
+// and weights, rather than pooling an Edge for each. Packed edges name their destination by
+// value, so they're only used where turning that back into a node is nearly always an array
+// lookup
+template <typename N, typename E>
+constexpr bool kPackedEdges = InternTable<N>::kDense && std::is_trivially_copyable_v<E>;
+
+}  // namespace detail
+
 template <typename N, typename E>
-class Graph {
+class CsrGraph;
+template <typename N, typename E, typename I>
+class SubgraphView;
+
+// I is the instrumentation policy, see instrumentation.h. The default compiles away
+template <typename N, typename E, typename I = NoInstrumentation>
+class Graph : private I {
  public:
+  // Dense handle for a node, assigned by InsertNode, so callers that have already resolved
+  // a node can skip key lookups. Valid until the node is deleted, after which the number
+  // may be handed out again. Copies of a graph keep the same ids
+  struct NodeId {
+    std::uint32_t value;
+
+    friend bool operator==(NodeId a, NodeId b) { return a.value == b.value; }
+    friend bool operator!=(NodeId a, NodeId b) { return a.value != b.value; }
+  };
+
   // Default constructor
-  Graph<N, E>() = default;
+  Graph<N, E, I>() = default;
 
   // Constructor for begin, end iterators
-  Graph<N, E>(typename std::vector<N>::const_iterator begin,
-              typename std::vector<N>::const_iterator end);
+  Graph<N, E, I>(typename std::vector<N>::const_iterator begin,
+                 typename std::vector<N>::const_iterator end);
 
   // Constructor for tuple begin, end iterators
-  Graph<N, E>(typename std::vector<std::tuple<N, N, E>>::const_iterator begin,
-              typename std::vector<std::tuple<N, N, E>>::const_iterator end);
+  Graph<N, E, I>(typename std::vector<std::tuple<N, N, E>>::const_iterator begin,
+                 typename std::vector<std::tuple<N, N, E>>::const_iterator end);
 
   // Constructor for initialiser list of nodes
-  Graph<N, E>(typename std::initializer_list<N> list);
+  Graph<N, E, I>(typename std::initializer_list<N> list);
 
-  // Copy constructor
-  Graph<N, E>(Graph& orig);
+  // Copy constructor, clones orig's structure directly rather than re-inserting into it
+  Graph<N, E, I>(const Graph& orig);
 
-  // Move constructor, default one is fine
-  Graph<N, E>(Graph&& original) = default;
+  // Move constructor, leaves original empty
+  Graph<N, E, I>(Graph&& original) : Graph<N, E, I>() { *this = std::move(original); }
 
-  // Destructor
-  ~Graph<N, E>() = default;
+  // Destructor, nodes and edges live in pools so they have to be destroyed by hand.
+  // Going out of scope isn't a change to record
+  ~Graph<N, E, I>() {
+    journal = nullptr;
+    Clear();
+  }
 
   // Copy assignment
-  // Uses logic of copy constructor and std::move to make this abomination
-  Graph<N, E>& operator=(const Graph<N, E>& orig) {
-    Graph<N, E> tmp;
-    for (const auto& i : orig.nodegraph) {
-      tmp.InsertNode(i.first);
-    }
-    // Entering the node
-    for (const auto& j : orig.nodegraph) {
-      // Entering the node's vector of edges
-      for (const auto& k : j.second->outEdges) {
-        // Entering the node's edge's src, dst, and weight
-        N src = k->getSource();
-        N dst = k->getDest();
-        E weight = k->getWeight();
-        tmp.InsertEdge(src, dst, weight);
-      }
+  // Uses the copy constructor and std::move
+  Graph<N, E, I>& operator=(const Graph<N, E, I>& orig) {
+    if (this != &orig) {
+      Graph<N, E, I> tmp{orig};
+      *this = std::move(tmp);
     }
-    *this = std::move(tmp);
     return *this;
   }
 
-  // Move assignment, default one is fine
-  Graph<N, E>& operator=(Graph<N, E>&&) = default;
+  // Move assignment, the old nodes have to be destroyed before their pools are replaced.
+  // Like the destructor that isn't a change to record, and neither is taking on orig's nodes
+  Graph<N, E, I>& operator=(Graph<N, E, I>&& orig) {
+    if (this != &orig) {
+      auto recording = journal;
+      journal = nullptr;
+      Clear();
+      journal = recording;
+      nodegraph = std::move(orig.nodegraph);
+      nodesById = std::move(orig.nodesById);
+      freeIds = std::move(orig.freeIds);
+      internTable = std::move(orig.internTable);
+      nodePool = std::move(orig.nodePool);
+      edgePool = std::move(orig.edgePool);
+      fingerprint = orig.fingerprint;
+      orig.Clear();
+    }
+    return *this;
+  }
+
+  // Whether out-edges are packed, see Node
+  static constexpr bool kPacked = detail::kPackedEdges<N, E>;
 
   // You HAVE TO declare class Edge prior to creating a vector of type 'Edge'
   class Edge;
 
+  // A node keeps its out-edges sorted by destination, then weight, in one of two layouts.
+  // Small trivially copyable types, like Graph<std::uint32_t, float>, are packed: the
+  // destination values and weights sit in two flat arrays, and in-edges are just the ids of
+  // their sources, so an edge costs sizeof(N) + sizeof(E) + 4 bytes. Everything else links
+  // pooled Edges, which never move or copy a weight once it's in the graph.
+  // Either way out-edges are read by position, 0 to degree() - 1
   class Node {
    public:
-    explicit Node(const N& inputValue) { value = inputValue; }
+    Node(const N& inputValue, std::uint32_t nodeId) : value{inputValue}, id{nodeId} {
+      rehash();
+    }
 
     N getValue() const { return value; }
+    std::uint32_t getId() const { return id; }
 
     // for iterator
-    N& getValueRef();
+    const N& getValueRef() const { return value; }
 
-    void setValue(N newValue) { this->value = newValue; }
+    void setValue(N newValue) {
+      this->value = newValue;
+      rehash();
+    }
+
+    // Mixed std::hash of the value, 0 if N can't be hashed
+    std::uint64_t getHash() const { return hash; }
 
-    std::shared_ptr<Edge> getEdge(const N& d, const E& w) const {
-      for (const auto& edge : outEdges) {
-        if ((edge->getWeight() == w) && (edge->getDest() == d)) {
-          return edge;
+    std::size_t degree() const {
+      if constexpr (kPacked) {
+        return dests.size();
+      } else {
+        return outEdges.size();
+      }
+    }
+    std::size_t inDegree() const {
+      if constexpr (kPacked) {
+        return sources.size();
+      } else {
+        return inEdges.size();
+      }
+    }
+    const N& destAt(std::size_t i) const {
+      if constexpr (kPacked) {
+        return dests[i];
+      } else {
+        return outEdges[i]->getDestRef();
+      }
+    }
+    const E& weightAt(std::size_t i) const {
+      if constexpr (kPacked) {
+        return weights[i];
+      } else {
+        return outEdges[i]->getWeightRef();
+      }
+    }
+
+    // iterator related help-functions
+    bool empty() const { return degree() == 0; }
+
+    // First out-edge not ordered before (d, w)
+    std::size_t lowerBound(const N& d, const E& w) const {
+      return detail::PartitionPoint(0, degree(), [this, &d, &w](std::size_t i) {
+        return std::tie(destAt(i), weightAt(i)) < std::tie(d, w);
+      });
+    }
+    // Out-edges going to d, in weight order
+    std::pair<std::size_t, std::size_t> destRange(const N& d) const {
+      auto first = detail::PartitionPoint(0, degree(),
+                                          [this, &d](std::size_t i) { return destAt(i) < d; });
+      auto last = detail::PartitionPoint(first, degree(),
+                                         [this, &d](std::size_t i) { return !(d < destAt(i)); });
+      return {first, last};
+    }
+
+    // Position of the out-edge to d with weight w, or degree()
+    std::size_t findEdge(const Node* d, const E& w) const {
+      auto i = lowerBound(d->getValueRef(), w);
+      if (i != degree() && destAt(i) == d->getValueRef() && weightAt(i) == w)
+        return i;
+      return degree();
+    }
+    bool hasEdge(const Node* d, const E& w) const {
+      if constexpr (!kPacked) {
+        if (!edgeIndex.empty()) {
+          auto [first, last] = edgeIndex.equal_range(d);
+          return std::any_of(first, last, [&w](const auto& e) {
+            return e.second->getWeightRef() == w;
+          });
         }
       }
-      // Return null pointer if can't find anything?
-      // Or throw exception
-      return nullptr;
+      return findEdge(d, w) != degree();
+    }
+    bool hasEdgeTo(const Node* d) const {
+      if constexpr (!kPacked) {
+        if (!edgeIndex.empty())
+          return edgeIndex.find(d) != edgeIndex.end();
+      }
+      auto [first, last] = destRange(d->getValueRef());
+      return first != last;
     }
 
-    std::vector<std::shared_ptr<Edge>> outEdges;
+    // All changes to the out-edges go through these, to keep them sorted and indexed.
+    // Inserting shifts the edges after the new one along, which is O(degree) though it only
+    // moves pointers or flat values, so loading a hub one edge at a time is quadratic.
+    // InsertEdges merges a whole batch into each node's list in one pass instead
 
-    // iterator related help-functions
-    bool empty() { return outEdges.empty(); }
-    // begin and end functions for iterator over inner edges
+    // Packed layout only, (d, w) mustn't be there already
+    void insertOutEdge(const N& d, const E& w) {
+      auto i = static_cast<std::ptrdiff_t>(lowerBound(d, w));
+      dests.insert(dests.begin() + i, d);
+      weights.insert(weights.begin() + i, w);
+    }
+    // added must be sorted and not hold any existing edge
+    void mergeOutEdges(const std::vector<std::pair<N, E>>& added) {
+      std::vector<N> mergedDests;
+      std::vector<E> mergedWeights;
+      mergedDests.reserve(dests.size() + added.size());
+      mergedWeights.reserve(dests.size() + added.size());
+      std::size_t i = 0;
+      for (const auto& [d, w] : added) {
+        for (; i < dests.size() && std::tie(dests[i], weights[i]) < std::tie(d, w); ++i) {
+          mergedDests.push_back(dests[i]);
+          mergedWeights.push_back(weights[i]);
+        }
+        mergedDests.push_back(d);
+        mergedWeights.push_back(w);
+      }
+      mergedDests.insert(mergedDests.end(), dests.begin() + static_cast<std::ptrdiff_t>(i),
+                         dests.end());
+      mergedWeights.insert(mergedWeights.end(),
+                           weights.begin() + static_cast<std::ptrdiff_t>(i), weights.end());
+      dests.swap(mergedDests);
+      weights.swap(mergedWeights);
+    }
 
-    static bool edgeSort(std::shared_ptr<Graph::Edge> v1, std::shared_ptr<Graph::Edge> v2) {
-      if (v1->getSourceRef() < v2->getSourceRef())
-        return true;
-      else if (v2->getSourceRef() < v1->getSourceRef())
-        return false;
-      if (v1->getDestRef() < v2->getDestRef())
-        return true;
-      else if (v2->getDestRef() < v1->getDestRef())
-        return false;
-      if (v1->getWeightRef() < v2->getWeightRef())
-        return true;
-      else if (v2->getWeightRef() < v1->getWeightRef())
-        return false;
+    // Linked layout only
+    void addOutEdge(Edge* edge) {
+      outEdges.insert(std::upper_bound(outEdges.begin(), outEdges.end(), edge, edgeSort), edge);
+      indexAdded(&edge, &edge + 1);
+    }
+    // For a list that is already sorted with edgeSort, e.g. when copying a graph
+    void assignOutEdges(std::vector<Edge*> sorted) {
+      outEdges = std::move(sorted);
+      edgeIndex.clear();
+      indexAdded(outEdges.data(), outEdges.data() + outEdges.size());
+    }
+    // added must be sorted with edgeSort and not hold any existing edge
+    void mergeOutEdges(const std::vector<Edge*>& added) {
+      std::vector<Edge*> merged;
+      merged.reserve(outEdges.size() + added.size());
+      std::merge(outEdges.begin(), outEdges.end(), added.begin(), added.end(),
+                 std::back_inserter(merged), edgeSort);
+      outEdges.swap(merged);
+      indexAdded(added.data(), added.data() + added.size());
+    }
 
-      return true;
+    // Removes the out-edge at i. A linked edge is handed back, since it still has to come
+    // out of its destination's in-edges and be destroyed
+    Edge* eraseOutEdge(std::size_t i) {
+      auto pos = static_cast<std::ptrdiff_t>(i);
+      if constexpr (kPacked) {
+        dests.erase(dests.begin() + pos);
+        weights.erase(weights.begin() + pos);
+        return nullptr;
+      } else {
+        auto edge = outEdges[i];
+        auto [first, last] = edgeIndex.equal_range(edge->getDestNode());
+        for (auto it = first; it != last; ++it) {
+          if (it->second == edge) {
+            edgeIndex.erase(it);
+            break;
+          }
+        }
+        outEdges.erase(outEdges.begin() + pos);
+        return edge;
+      }
+    }
+    void removeOutEdgesTo(const Node* d) {
+      auto [first, last] = destRange(d->getValueRef());
+      auto from = static_cast<std::ptrdiff_t>(first);
+      auto to = static_cast<std::ptrdiff_t>(last);
+      if constexpr (kPacked) {
+        dests.erase(dests.begin() + from, dests.begin() + to);
+        weights.erase(weights.begin() + from, weights.begin() + to);
+      } else {
+        outEdges.erase(outEdges.begin() + from, outEdges.begin() + to);
+        edgeIndex.erase(d);
+      }
+    }
+    // The out-edges in [first, last) all go to a node that has just been renamed to val,
+    // which no other out-edge goes to. They stay in weight order, so the run only has to
+    // move to where val sorts
+    void renameDest(std::size_t first, std::size_t last, const N& val) {
+      if constexpr (kPacked) {
+        std::fill(dests.begin() + static_cast<std::ptrdiff_t>(first),
+                  dests.begin() + static_cast<std::ptrdiff_t>(last), val);
+      }
+      const auto rotate = [this](std::size_t a, std::size_t b, std::size_t c) {
+        if constexpr (kPacked) {
+          std::rotate(dests.begin() + static_cast<std::ptrdiff_t>(a),
+                      dests.begin() + static_cast<std::ptrdiff_t>(b),
+                      dests.begin() + static_cast<std::ptrdiff_t>(c));
+          std::rotate(weights.begin() + static_cast<std::ptrdiff_t>(a),
+                      weights.begin() + static_cast<std::ptrdiff_t>(b),
+                      weights.begin() + static_cast<std::ptrdiff_t>(c));
+        } else {
+          std::rotate(outEdges.begin() + static_cast<std::ptrdiff_t>(a),
+                      outEdges.begin() + static_cast<std::ptrdiff_t>(b),
+                      outEdges.begin() + static_cast<std::ptrdiff_t>(c));
+        }
+      };
+      const auto before = [this, &val](std::size_t i) { return destAt(i) < val; };
+      auto to = detail::PartitionPoint(0, first, before);
+      if (to < first) {
+        rotate(to, first, last);
+      } else {
+        rotate(first, last, detail::PartitionPoint(last, degree(), before));
+      }
     }
-    typename std::vector<std::shared_ptr<Edge>>::iterator begin() {
-      sort(outEdges.begin(), outEdges.end(), edgeSort);
-      return outEdges.begin();
+
+    // In-edges are in no particular order. A linked edge knows its position in them, so all
+    // changes to inEdges go through these to keep that up to date
+    void addInEdge(Edge* edge) {
+      edge->setInPos(inEdges.size());
+      inEdges.push_back(edge);
     }
-    typename std::vector<std::shared_ptr<Edge>>::iterator end() {
-      sort(outEdges.begin(), outEdges.end(), edgeSort);
-      return outEdges.end();
+    // Swaps the last in-edge into its place
+    void removeInEdge(Edge* edge) {
+      auto last = inEdges.back();
+      last->setInPos(edge->getInPos());
+      inEdges[edge->getInPos()] = last;
+      inEdges.pop_back();
     }
-    typename std::vector<std::shared_ptr<Edge>>::reverse_iterator rbegin() {
-      sort(outEdges.begin(), outEdges.end(), edgeSort);
-      return outEdges.rbegin();
+    void removeInEdgesFrom(const Node* src) {
+      if constexpr (kPacked) {
+        sources.erase(std::remove(sources.begin(), sources.end(), src->getId()), sources.end());
+      } else {
+        std::size_t kept = 0;
+        for (const auto& edge : inEdges) {
+          if (edge->getSourceNode() != src) {
+            edge->setInPos(kept);
+            inEdges[kept++] = edge;
+          }
+        }
+        inEdges.resize(kept);
+      }
     }
-    typename std::vector<std::shared_ptr<Edge>>::reverse_iterator rend() {
-      sort(outEdges.begin(), outEdges.end(), edgeSort);
-      return outEdges.rend();
+    // Packed layout only, takes out one in-edge from src and returns where it was.
+    // Packed out-edges don't keep a position for it, that would cost more than the edge
+    // itself, so this is a scan over the in-edges
+    std::size_t removeSource(std::uint32_t src) {
+      auto it = std::find(sources.begin(), sources.end(), src);
+      auto pos = static_cast<std::size_t>(it - sources.begin());
+      *it = sources.back();
+      sources.pop_back();
+      return pos;
     }
 
+    // Nodes with more out-edges than this also hash them by destination, so duplicate
+    // checks and IsConnected on hub nodes don't depend on their degree. Linked layout only,
+    // a packed node's binary search is over one flat array
+    static constexpr std::size_t kEdgeIndexThreshold = 64;
+
+    // Linked layout: pooled edges, out-edges always sorted with edgeSort
+    std::conditional_t<kPacked, detail::Unused, std::vector<Edge*>> outEdges;
+    // Edges whose destination is this node, so node operations don't scan the graph
+    std::conditional_t<kPacked, detail::Unused, std::vector<Edge*>> inEdges;
+
+    // Packed layout: the destination and weight of each out-edge, side by side, and the
+    // source id of each in-edge
+    std::conditional_t<kPacked, std::vector<N>, detail::Unused> dests;
+    std::conditional_t<kPacked, std::vector<E>, detail::Unused> weights;
+    std::conditional_t<kPacked, std::vector<std::uint32_t>, detail::Unused> sources;
+
    private:
     N value;
+    std::uint32_t id;
+    std::uint64_t hash = 0;
+
+    void rehash() {
+      if constexpr (detail::IsHashable<N>::value) {
+        hash = detail::Mix(std::hash<N>{}(value));
+      }
+    }
+
+    // Orders a node's out-edges by destination, then weight
+    static bool edgeSort(Edge* v1, Edge* v2) {
+      return std::tie(v1->getDestRef(), v1->getWeightRef()) <
+             std::tie(v2->getDestRef(), v2->getWeightRef());
+    }
+
+    // Keeps edgeIndex up to date once edges in [first, last) are in outEdges
+    void indexAdded(Edge* const* first, Edge* const* last) {
+      if (!edgeIndex.empty()) {
+        for (; first != last; ++first) {
+          edgeIndex.emplace((*first)->getDestNode(), *first);
+        }
+      } else if (outEdges.size() > kEdgeIndexThreshold) {
+        for (const auto& e : outEdges) {
+          edgeIndex.emplace(e->getDestNode(), e);
+        }
+      }
+    }
+
+    // Either empty or holds every out-edge, keyed by destination
+    std::conditional_t<kPacked, detail::Unused, std::unordered_multimap<const Node*, Edge*>>
+        edgeIndex;
   };
 
+  // Only used by the linked layout
   class Edge {
    public:
     // Edge(nodeSource, nodeDestination, nodeWeight);
-    Edge(std::shared_ptr<Node> nodeSource,
-         std::shared_ptr<Node> nodeDestination,
-         const E& nodeWeight) {
-      source = nodeSource;
-      destination = nodeDestination;
-      weight = nodeWeight;
-    }
+    Edge(Node* nodeSource, Node* nodeDestination, const E& nodeWeight)
+      : source{nodeSource}, destination{nodeDestination}, weight{nodeWeight} {}
 
     E getWeight() const { return weight; }
 
-    // You can only access the contents of a weak_ptr by creating the shared_ptr equivalent (via
-    // lock)
-    N getSource() const;
-    N getDest() const;
+    N getSource() const { return source->getValue(); }
+    N getDest() const { return destination->getValue(); }
+    Node* getSourceNode() const { return source; }
+    Node* getDestNode() const { return destination; }
 
     // for iterators
-    E& getWeightRef();
-    N& getSourceRef();
-    N& getDestRef();
+    const E& getWeightRef() const { return weight; }
+    const N& getSourceRef() const { return source->getValueRef(); }
+    const N& getDestRef() const { return destination->getValueRef(); }
 
-    void setDest(std::shared_ptr<Node> newDestination) { this->destination = newDestination; }
+    // Where the edge is in its destination's inEdges
+    std::size_t getInPos() const { return inPos; }
+    void setInPos(std::size_t pos) { inPos = pos; }
 
    private:
-    // If the shared pointer for node
-    // disappears, these weak pointers  will also disappear (good)
-    std::weak_ptr<Node> source;
-    std::weak_ptr<Node> destination;
+    // Plain pointers are safe since a node's in and out edges are always removed before
+    // the node itself is
+    Node* source;
+    Node* destination;
     // Weight in type E
     E weight;
+    std::size_t inPos = 0;
   };
 
+  // Read-only view over a run of one node's out-edges, in sorted order.
+  // Values are read in place rather than copied, so a view is only good until the graph
+  // next changes
+  template <typename Project>
+  class EdgeView {
+   public:
+    class iterator {
+     public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using reference = decltype(Project{}(std::declval<const Node*>(), std::size_t{}));
+      using value_type = std::decay_t<reference>;
+      using pointer = void;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      reference operator*() const { return Project{}(node_, edge_); }
+      iterator& operator++() {
+        ++edge_;
+        return *this;
+      }
+      iterator operator++(int) { return iterator{node_, edge_++}; }
+      iterator& operator--() {
+        --edge_;
+        return *this;
+      }
+      iterator operator--(int) { return iterator{node_, edge_--}; }
+
+      friend bool operator==(const iterator& lhs, const iterator& rhs) {
+        return lhs.node_ == rhs.node_ && lhs.edge_ == rhs.edge_;
+      }
+      friend bool operator!=(const iterator& lhs, const iterator& rhs) { return !(lhs == rhs); }
+
+     private:
+      const Node* node_ = nullptr;
+      std::size_t edge_ = 0;
+
+      friend class EdgeView;
+      iterator(const Node* node, std::size_t edge) : node_{node}, edge_{edge} {}
+    };
+
+    iterator begin() const { return iterator{node_, first_}; }
+    iterator end() const { return iterator{node_, last_}; }
+    std::size_t size() const { return last_ - first_; }
+    bool empty() const { return first_ == last_; }
+    typename iterator::reference operator[](std::size_t i) const {
+      return Project{}(node_, first_ + i);
+    }
+    typename iterator::reference front() const { return Project{}(node_, first_); }
+    typename iterator::reference back() const { return Project{}(node_, last_ - 1); }
+
+   private:
+    const Node* node_;
+    std::size_t first_;
+    std::size_t last_;
+
+    friend class Graph;
+    EdgeView(const Node* node, std::size_t first, std::size_t last)
+      : node_{node}, first_{first}, last_{last} {}
+  };
+
+  struct DestOf {
+    const N& operator()(const Node* node, std::size_t i) const { return node->destAt(i); }
+  };
+  struct WeightOf {
+    const E& operator()(const Node* node, std::size_t i) const { return node->weightAt(i); }
+  };
+  struct DestAndWeightOf {
+    std::tuple<const N&, const E&> operator()(const Node* node, std::size_t i) const {
+      return {node->destAt(i), node->weightAt(i)};
+    }
+  };
+  // Destination of every out-edge, the same values GetConnected returns
+  using NeighborView = EdgeView<DestOf>;
+  // Weights of the edges between two nodes, the same values GetWeights returns
+  using WeightView = EdgeView<WeightOf>;
+  // (dest, weight) of every out-edge
+  using OutEdgeView = EdgeView<DestAndWeightOf>;
+
   bool InsertNode(const N&);
   bool InsertEdge(const N&, const N&, const E&);
   bool DeleteNode(const N&);
@@ -173,50 +570,112 @@ class Graph {
   void MergeReplace(const N&, const N&);
   void Clear();
   bool erase(const N& src, const N& dst, const E& w);
-  bool IsNode(const N&);
-  bool IsConnected(const N& src, const N& dst);
+  bool IsNode(const N&) const;
+  bool IsConnected(const N& src, const N& dst) const;
 
   std::vector<N> GetNodes(void) const;
   std::vector<N> GetConnected(const N& src) const;
   std::vector<E> GetWeights(const N& src, const N& dst) const;
 
-  friend std::ostream& operator<<(std::ostream& os, const gdwg::Graph<N, E>& g) {
+  // Views over the stored adjacency, which don't copy or allocate
+  NeighborView Neighbors(const N& src) const;
+  WeightView Weights(const N& src, const N& dst) const;
+  OutEdgeView OutEdges(const N& src) const;
+
+  // Inserts a batch of (src, dst, weight) edges, creating any missing nodes and skipping
+  // edges that already exist or repeat within the batch. Sorting the batch first lets each
+  // node's new edges be merged into its list in one pass. Returns how many were inserted
+  template <typename InputIt>
+  std::size_t InsertEdges(InputIt first, InputIt last);
+  std::size_t InsertEdges(const std::vector<std::tuple<N, N, E>>& edges) {
+    return InsertEdges(edges.begin(), edges.end());
+  }
+  // Builds a graph from nothing but an edge list, through InsertEdges
+  static Graph<N, E, I> FromEdgeList(const std::vector<std::tuple<N, N, E>>& edges);
+
+  // Same operations on already resolved node ids
+  NodeId GetId(const N& val) const;
+  const N& GetValue(NodeId id) const;
+  bool InsertEdge(NodeId src, NodeId dst, const E& w);
+  bool erase(NodeId src, NodeId dst, const E& w);
+  bool IsNode(NodeId id) const;
+  bool IsConnected(NodeId src, NodeId dst) const;
+
+  // Whether there is a path from src to dst, every node reaches itself. The first call
+  // builds a reachability index, which later changes then keep up to date.
+  // Though const it writes to the graph, building or rebuilding the index, so it isn't safe
+  // to call from several threads at once even when nothing else changes the graph
+  bool IsReachable(const N& src, const N& dst) const;
+  bool IsReachable(NodeId src, NodeId dst) const;
+  std::vector<N> GetConnected(NodeId src) const;
+  std::vector<E> GetWeights(NodeId src, NodeId dst) const;
+  NeighborView Neighbors(NodeId src) const;
+  WeightView Weights(NodeId src, NodeId dst) const;
+  OutEdgeView OutEdges(NodeId src) const;
+  // One more than the largest id in use, for sizing arrays indexed by NodeId::value
+  std::size_t IdBound() const { return nodesById.size(); }
+
+  // Order independent 64-bit hash of every node and edge, kept up to date by each mutation,
+  // so graphs with different fingerprints are unequal. Only available when N and E work with
+  // std::hash, and only comparable within one process
+  std::uint64_t Fingerprint() const {
+    static_assert(kFingerprinted, "Graph::Fingerprint needs std::hash for N and E");
+    return fingerprint;
+  }
+
+  // The instrumentation policy, e.g. Stats()[GraphOp::kFind].calls with
+  // CountingInstrumentation
+  const I& Stats() const { return *this; }
+
+  // Compacts the graph into a read-only snapshot with the same read API
+  CsrGraph<N, E> Freeze() const;
+
+  // Writes every later change to log, or stops if log is nullptr. The log has to outlive
+  // the recording. Copies of a graph don't record, and assigning to or from one isn't recorded
+  void Record(MutationLog<N, E>* log) {
+    static_assert(detail::kLoggable<N> && detail::kLoggable<E>,
+                  "Graph::Record needs trivially copyable or std::string nodes and weights");
+    journal = log;
+  }
+  MutationLog<N, E>* Recording() const { return journal; }
+
+  friend std::ostream& operator<<(std::ostream& os, const gdwg::Graph<N, E, I>& g) {
     for (auto const& [key, val] : g.nodegraph) {
       os << key << " (" << std::endl;
-      // auto i = val->outEdges;
-      sort(val->outEdges.begin(), val->outEdges.end(), Node::edgeSort);
-      for (std::shared_ptr<Edge> edges : val->outEdges) {
-        os << "  " << edges->getDest() << " | " << edges->getWeight() << std::endl;
+      for (std::size_t i = 0; i < val->degree(); ++i) {
+        os << "  " << val->destAt(i) << " | " << val->weightAt(i) << std::endl;
       }
       os << ")" << std::endl;
     }
     return os;
   }
-  friend bool operator==(const gdwg::Graph<N, E>& a, const gdwg::Graph<N, E>& b) {
+  friend bool operator==(const gdwg::Graph<N, E, I>& a, const gdwg::Graph<N, E, I>& b) {
+    if constexpr (kFingerprinted) {
+      if (a.fingerprint != b.fingerprint)
+        return false;
+    }
     // Check nodes
-    if (a.GetNodes().size() == b.GetNodes().size()) {
-      auto nodeVecA = a.GetNodes();
-      auto nodeVecB = b.GetNodes();
-      for (int i = 0; i < static_cast<int>(nodeVecA.size()); ++i) {
-        if (nodeVecA[i] != nodeVecB[i])
+    if (a.nodegraph.size() != b.nodegraph.size())
+      return false;
+    // Nodes and their out-edges are in the same order in both, so walk them side by side
+    auto nodeB = b.nodegraph.begin();
+    for (const auto& [key, val] : a.nodegraph) {
+      const auto edgesB = nodeB->second;
+      if (key != nodeB->first || val->degree() != edgesB->degree())
+        return false;
+      for (std::size_t i = 0; i < edgesB->degree(); ++i) {
+        if (val->destAt(i) != edgesB->destAt(i) || val->weightAt(i) != edgesB->weightAt(i))
           return false;
       }
-      for (const auto& edgeA : nodeVecA) {
-        for (const auto& edgeB : nodeVecB) {
-          if (a.GetWeights(edgeA, edgeB) != b.GetWeights(edgeA, edgeB))
-            return false;
-        }
-      }
-    } else {
-      return false;
+      ++nodeB;
     }
     return true;
   }
-  friend bool operator!=(const gdwg::Graph<N, E>& a, const gdwg::Graph<N, E>& b) {
+  friend bool operator!=(const gdwg::Graph<N, E, I>& a, const gdwg::Graph<N, E, I>& b) {
     return (!(a == b));
   }
 
-  class const_iterator {
+  class const_iterator : private I::Cursor {
     using iterator_category = std::bidirectional_iterator_tag;
     using value_type = std::tuple<N, N, E>;
     using reference = std::tuple<const N&, const N&, const E&>;
@@ -236,7 +695,7 @@ class Graph {
 
     friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
       return ((lhs.node_it_ == rhs.node_it_) &&
-              (lhs.node_it_ == lhs.sentinel_ || lhs.edge_it_ == rhs.edge_it_));
+              (lhs.node_it_ == lhs.sentinel_ || lhs.edge_ == rhs.edge_));
     }
 
     friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
@@ -244,19 +703,21 @@ class Graph {
     }
 
    private:
-    typename std::map<N, std::shared_ptr<Node>>::iterator node_it_;  // out-most iterator
-    typename std::map<N, std::shared_ptr<Node>>::iterator sentinel_;
+    typename std::map<N, Node*>::const_iterator node_it_;  // out-most iterator
+    typename std::map<N, Node*>::const_iterator sentinel_;
     // end of nodes
-    typename std::vector<std::shared_ptr<Edge>>::iterator edge_it_;  // edge_  inner iterator*/
+    // position in that node's out-edges
+    std::size_t edge_;
 
     friend class Graph;
-    const_iterator(const decltype(node_it_)& node1_it,
+    const_iterator(const I* owner,
+                   const decltype(node_it_)& node1_it,
                    const decltype(sentinel_)& sentinel,
-                   const decltype(edge_it_)& edge_it)
-      : node_it_{node1_it}, sentinel_{sentinel}, edge_it_{edge_it} {}
+                   std::size_t edge)
+      : I::Cursor{owner}, node_it_{node1_it}, sentinel_{sentinel}, edge_{edge} {}
   };
 
-  class const_reverse_iterator {
+  class const_reverse_iterator : private I::Cursor {
     using iterator_category = std::bidirectional_iterator_tag;
     using value_type = std::tuple<N, N, E>;
     using reference = std::tuple<const N&, const N&, const E&>;
@@ -273,7 +734,7 @@ class Graph {
 
     friend bool operator==(const const_reverse_iterator& lhs, const const_reverse_iterator& rhs) {
       return ((lhs.node_it_ == rhs.node_it_) &&
-              (lhs.node_it_ == lhs.sentinel_ || lhs.edge_it_ == rhs.edge_it_));
+              (lhs.node_it_ == lhs.sentinel_ || lhs.edge_ == rhs.edge_));
     }
 
     friend bool operator!=(const const_reverse_iterator& lhs, const const_reverse_iterator& rhs) {
@@ -281,35 +742,84 @@ class Graph {
     }
 
    private:
-    typename std::map<N, std::shared_ptr<Node>>::reverse_iterator node_it_;  // out-most iterator
-    typename std::map<N, std::shared_ptr<Node>>::reverse_iterator sentinel_;
-    // typename std::vector<std::vector<N>>::iterator node2_it_; // other_node_container_for_node
-    typename std::vector<std::shared_ptr<Edge>>::reverse_iterator
-        edge_it_; /*other_edge_container_for_node_pair(edge_  inner iterator*/
+    // out-most iterator
+    typename std::map<N, Node*>::const_reverse_iterator node_it_;
+    typename std::map<N, Node*>::const_reverse_iterator sentinel_;
+    // One past the current edge's position in that node's out-edges, counting down, like
+    // std::reverse_iterator
+    std::size_t edge_;
 
     friend class Graph;
-    const_reverse_iterator(const decltype(node_it_)& node1_it,
+    const_reverse_iterator(const I* owner,
+                           const decltype(node_it_)& node1_it,
                            const decltype(sentinel_)& sentinel,
-                           const decltype(edge_it_)& edge_it)
-      : node_it_{node1_it}, sentinel_{sentinel}, edge_it_{edge_it} {}
+                           std::size_t edge)
+      : I::Cursor{owner}, node_it_{node1_it}, sentinel_{sentinel}, edge_{edge} {}
   };
 
-  const_iterator const begin();
-  const_iterator const end();
-  const_reverse_iterator const rbegin();
-  const_reverse_iterator const rend();
-  const_iterator const cbegin();
-  const_iterator const cend();
-  const_reverse_iterator const crbegin();
-  const_reverse_iterator const crend();
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_reverse_iterator rbegin() const;
+  const_reverse_iterator rend() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  const_reverse_iterator crbegin() const;
+  const_reverse_iterator crend() const;
   const_iterator erase(const_iterator it);
   const_iterator const find(const N& source, const N& dest, const E& weight);
 
  private:
-  std::map<N, std::shared_ptr<Node>> nodegraph;
+  // Every node and edge lives in these, the rest of the graph points into them
+  detail::Pool<Node> nodePool;
+  detail::Pool<Edge> edgePool;
+
+  // Ordered by value, for GetNodes, operator<< and iteration
+  std::map<N, Node*> nodegraph;
+  // Indexed by node id, nullptr where a deleted node's id is waiting to be reused
+  std::vector<Node*> nodesById;
+  std::vector<std::uint32_t> freeIds;
+  // Node value to id, which is what every value-based lookup goes through
+  detail::InternTable<N> internTable;
+
+  static constexpr bool kFingerprinted =
+      detail::IsHashable<N>::value && detail::IsHashable<E>::value;
+  // Sum of the hashes of every node and edge, so it can be updated in either direction
+  std::uint64_t fingerprint = 0;
+  void addToFingerprint(const Node* node, bool add);
+  void addToFingerprint(const Node* src, const Node* dst, const E& w, bool add);
+
+  static constexpr std::uint32_t kNoId = detail::InternTable<N>::kMissing;
+  // Id of val, or kNoId
+  std::uint32_t idOf(const N& val) const;
+  // Creates a node for val, which must not exist yet, and returns its id
+  std::uint32_t addNode(const N& val);
+  // Node for val, created if it doesn't exist yet
+  Node* findOrAddNode(const N& val);
+  // Drops a node whose edges have already been removed
+  void removeNode(std::uint32_t id);
+  // The other end of node's out-edge at i, or of its i-th in-edge
+  Node* destNode(const Node* node, std::size_t i) const;
+  Node* sourceNode(const Node* node, std::size_t i) const;
+
+  // Adds an edge to both the source's out-edges and the destination's in-edges,
+  // returns false if it already exists
+  bool linkEdge(Node* src, Node* dst, const E& w);
+  // Removes src's out-edge at pos from both of its endpoints, pos is then the next one
+  void unlinkEdgeAt(Node* src, std::size_t pos);
+
+  // Built by the first IsReachable, points into this graph so it isn't copied or moved.
+  // Written from const methods, so const calls that read it aren't thread safe
+  mutable std::unique_ptr<detail::ReachabilityIndex<Graph>> reachability;
+  // Set by Record, never copied or moved
+  MutationLog<N, E>* journal = nullptr;
+
+  friend class CsrGraph<N, E>;
+  friend class SubgraphView<N, E, I>;
+  friend class detail::ReachabilityIndex<Graph>;
 };
 
 }  // namespace gdwg
 #include "assignments/dg/graph.tpp"
+#include "assignments/dg/csr_graph.h"
 
 #endif  // ASSIGNMENTS_DG_GRAPH_H_
@@ -1,468 +1,896 @@
 #include <algorithm>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 #include <tuple>
 #include <utility>
 #include <vector>
 
 // Constructor for begin, end iterators
-template <typename N, typename E>
-gdwg::Graph<N, E>::Graph(typename std::vector<N>::const_iterator begin,
-                         typename std::vector<N>::const_iterator end) {
+template <typename N, typename E, typename I>
+gdwg::Graph<N, E, I>::Graph(typename std::vector<N>::const_iterator begin,
+                            typename std::vector<N>::const_iterator end) {
   for (auto i = begin; i != end; ++i) {
-    nodegraph[*i] = std::make_shared<Node>(*i);
+    InsertNode(*i);
   }
 }
 
 // Constructor for tuple begin, end iterators
-template <typename N, typename E>
-gdwg::Graph<N, E>::Graph(typename std::vector<std::tuple<N, N, E>>::const_iterator begin,
-                         typename std::vector<std::tuple<N, N, E>>::const_iterator end) {
-  for (auto i = begin; i != end; ++i) {
-    auto source_val = std::get<0>(*i);
-    auto dest_val = std::get<1>(*i);
-    auto weight_val = std::get<2>(*i);
-
-    // If either source or dest doesn't exist, create it
-    if (!nodegraph[source_val]) {
-      nodegraph[source_val] = std::make_shared<Node>(source_val);
-    }
-    if (!nodegraph[dest_val]) {
-      nodegraph[dest_val] = std::make_shared<Node>(dest_val);
-    }
-
-    // Now add edges
-    // nodegraph.find(source_val)->second POINTS TO THE NODE
-    // ->getValue() finds the value of the node
-
-    auto source = nodegraph.find(source_val)->second;
-    auto dest = nodegraph.find(dest_val)->second;
-    auto edge = std::make_shared<Edge>(source, dest, weight_val);
-
-    // Will make this private later
-    // when we do, we'll have to change this
-    source->outEdges.push_back(edge);
-  }
+template <typename N, typename E, typename I>
+gdwg::Graph<N, E, I>::Graph(typename std::vector<std::tuple<N, N, E>>::const_iterator begin,
+                            typename std::vector<std::tuple<N, N, E>>::const_iterator end) {
+  InsertEdges(begin, end);
 }
 
 // Constructor for initialiser list of nodes
-template <typename N, typename E>
-gdwg::Graph<N, E>::Graph(typename std::initializer_list<N> list) {
+template <typename N, typename E, typename I>
+gdwg::Graph<N, E, I>::Graph(typename std::initializer_list<N> list) {
   for (auto i = list.begin(); i != list.end(); ++i) {
-    nodegraph[*i] = std::make_shared<Node>(*i);
+    InsertNode(*i);
   }
 }
 
 // Copy constructor
-template <typename N, typename E>
-gdwg::Graph<N, E>::Graph(Graph& orig) {
-  for (const auto& i : orig.nodegraph) {
-    InsertNode(i.first);
-  }
-
-  // Entering the node
-  for (const auto& j : orig.nodegraph) {
-    // Entering the node's vector of edges
-    for (const auto& k : j.second->outEdges) {
-      // Entering the node's edge's src, dst, and weight
-      N src = k->getSource();
-      N dst = k->getDest();
-      E weight = k->getWeight();
-      InsertEdge(src, dst, weight);
+// orig is already valid, so there's nothing to look up or check. Nodes keep their ids,
+// which is all that's needed to remap each edge's endpoints into the copy
+template <typename N, typename E, typename I>
+gdwg::Graph<N, E, I>::Graph(const Graph& orig)
+  : nodesById(orig.nodesById.size()), freeIds{orig.freeIds}, internTable{orig.internTable},
+    fingerprint{orig.fingerprint} {
+  for (const auto& [key, val] : orig.nodegraph) {
+    auto node = nodePool.create(key, val->getId());
+    // Packed edges only hold values and ids, which are the same in the copy
+    if constexpr (kPacked) {
+      node->dests = val->dests;
+      node->weights = val->weights;
+      node->sources = val->sources;
+    } else {
+      node->inEdges.reserve(val->inEdges.size());
+    }
+    nodesById[val->getId()] = node;
+    // Values come out of orig in order, so each one goes at the end
+    nodegraph.emplace_hint(nodegraph.end(), key, node);
+  }
+  if constexpr (!kPacked) {
+    for (const auto& [key, val] : orig.nodegraph) {
+      auto source = nodesById[val->getId()];
+      std::vector<Edge*> copied;
+      copied.reserve(val->outEdges.size());
+      for (const auto& edge : val->outEdges) {
+        auto dest = nodesById[edge->getDestNode()->getId()];
+        auto copy = edgePool.create(source, dest, edge->getWeightRef());
+        copied.push_back(copy);
+        dest->addInEdge(copy);
+      }
+      source->assignOutEdges(std::move(copied));
+      (void)key;
     }
   }
 }
 
+// Looks a value up in the intern table
+template <typename N, typename E, typename I>
+std::uint32_t gdwg::Graph<N, E, I>::idOf(const N& val) const {
+  return internTable.find(val);
+}
+
+// Creates a node, reusing the id of a deleted node if there is one
+template <typename N, typename E, typename I>
+std::uint32_t gdwg::Graph<N, E, I>::addNode(const N& val) {
+  std::uint32_t id;
+  if (freeIds.empty()) {
+    id = static_cast<std::uint32_t>(nodesById.size());
+    nodesById.emplace_back();
+  } else {
+    id = freeIds.back();
+    freeIds.pop_back();
+  }
+  nodesById[id] = nodePool.create(val, id);
+  this->allocated(1);
+  nodegraph.emplace(val, nodesById[id]);
+  internTable.emplace(val, id);
+  addToFingerprint(nodesById[id], true);
+  if (reachability)
+    reachability->NodeAdded(id);
+  if (journal)
+    journal->node(Mutation::kInsertNode, val);
+  return id;
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::Node* gdwg::Graph<N, E, I>::findOrAddNode(const N& val) {
+  auto id = idOf(val);
+  if (id == kNoId) {
+    id = addNode(val);
+  }
+  return nodesById[id];
+}
+
+// Drops a node once its edges are gone, its id can then be reused
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::removeNode(std::uint32_t id) {
+  auto node = nodesById[id];
+  if (journal)
+    journal->node(Mutation::kDeleteNode, node->getValueRef());
+  addToFingerprint(node, false);
+  internTable.erase(node->getValueRef());
+  nodegraph.erase(node->getValueRef());
+  nodePool.destroy(node);
+  nodesById[id] = nullptr;
+  freeIds.push_back(id);
+  if (reachability)
+    reachability->NodeRemoved(id);
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::Node* gdwg::Graph<N, E, I>::destNode(const Node* node,
+                                                                    std::size_t i) const {
+  if constexpr (kPacked) {
+    return nodesById[idOf(node->dests[i])];
+  } else {
+    return node->outEdges[i]->getDestNode();
+  }
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::Node* gdwg::Graph<N, E, I>::sourceNode(const Node* node,
+                                                                      std::size_t i) const {
+  if constexpr (kPacked) {
+    return nodesById[node->sources[i]];
+  } else {
+    return node->inEdges[i]->getSourceNode();
+  }
+}
+
+// Adds or takes away one node's share of the fingerprint
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::addToFingerprint(const Node* node, bool add) {
+  if constexpr (kFingerprinted) {
+    fingerprint += add ? node->getHash() : 0 - node->getHash();
+  } else {
+    (void)node;
+    (void)add;
+  }
+}
+
+// An edge's share mixes both endpoints in order, so a->b and b->a hash differently
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::addToFingerprint(const Node* src,
+                                            const Node* dst,
+                                            const E& w,
+                                            bool add) {
+  if constexpr (kFingerprinted) {
+    auto h = detail::Mix(src->getHash() ^
+                         detail::Mix(dst->getHash() ^ detail::Mix(std::hash<E>{}(w))));
+    fingerprint += add ? h : 0 - h;
+  } else {
+    (void)src;
+    (void)dst;
+    (void)w;
+    (void)add;
+  }
+}
+
 // Checks if node exists
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::IsNode(const N& val) {
-  if (nodegraph.find(val) == nodegraph.end())
-    return false;
-  return true;
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsNode(const N& val) const {
+  return idOf(val) != kNoId;
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsNode(NodeId id) const {
+  return id.value < nodesById.size() && nodesById[id.value] != nullptr;
 }
 
 // Inserts node of value 'val' into graph
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::InsertNode(const N& val) {
-  auto it = nodegraph.find(val);
-  if (it == nodegraph.end()) {
-    nodegraph[val] = std::make_shared<Node>(val);
-    return true;
-  }
-  return false;
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::InsertNode(const N& val) {
+  typename I::Scope scope{*this, GraphOp::kInsertNode};
+  if (idOf(val) != kNoId)
+    return false;
+  addNode(val);
+  return true;
 }
 
 // Inserts edge of weight 'w' between src and dst nodes
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::InsertEdge(const N& src, const N& dst, const E& w) {
-  if (!this->IsNode(src) || !this->IsNode(dst)) {
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::InsertEdge(const N& src, const N& dst, const E& w) {
+  typename I::Scope scope{*this, GraphOp::kInsertEdge};
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId) {
     throw std::runtime_error(
         "Cannot call Graph::InsertEdge when either src or dst node does not exist");
   }
-  auto source = nodegraph.find(src)->second;
-  auto destination = nodegraph.find(dst)->second;
-  auto edge = std::make_shared<Edge>(source, destination, w);
+  return linkEdge(nodesById[s], nodesById[d], w);
+}
 
-  // Return false because it already exists
-  for (const auto& e : source->outEdges) {
-    if (e->getDest() == dst && e->getWeight() == w) {
-      return false;
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::InsertEdge(NodeId src, NodeId dst, const E& w) {
+  typename I::Scope scope{*this, GraphOp::kInsertEdge};
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::runtime_error(
+        "Cannot call Graph::InsertEdge when either src or dst node does not exist");
+  }
+  return linkEdge(nodesById[src.value], nodesById[dst.value], w);
+}
+
+// Inserts a batch of edges, creating nodes as needed
+template <typename N, typename E, typename I>
+template <typename InputIt>
+std::size_t gdwg::Graph<N, E, I>::InsertEdges(InputIt first, InputIt last) {
+  typename I::Scope scope{*this, GraphOp::kInsertEdges};
+  // Resolve every endpoint once, up front
+  std::vector<std::tuple<Node*, Node*, E>> batch;
+  if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                  typename std::iterator_traits<InputIt>::iterator_category>) {
+    batch.reserve(static_cast<std::size_t>(std::distance(first, last)));
+  }
+  for (; first != last; ++first) {
+    const auto& [src, dst, w] = *first;
+    auto source = findOrAddNode(src);
+    batch.emplace_back(source, findOrAddNode(dst), w);
+  }
+
+  // Group by source, each group in the same order as out-edges, so duplicates end up adjacent
+  std::sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) {
+    if (std::get<0>(a) != std::get<0>(b))
+      return std::get<0>(a)->getId() < std::get<0>(b)->getId();
+    return std::tie(std::get<1>(a)->getValueRef(), std::get<2>(a)) <
+           std::tie(std::get<1>(b)->getValueRef(), std::get<2>(b));
+  });
+
+  batch.erase(std::unique(batch.begin(), batch.end(),
+                          [](const auto& a, const auto& b) {
+                            return std::get<0>(a) == std::get<0>(b) &&
+                                   std::get<1>(a) == std::get<1>(b) &&
+                                   std::get<2>(a) == std::get<2>(b);
+                          }),
+              batch.end());
+
+  std::size_t inserted = 0;
+  // One source's new edges, in whichever layout it uses
+  std::vector<Edge*> linked;
+  std::vector<std::pair<N, E>> packed;
+  std::vector<Node*> reached;
+  for (auto it = batch.begin(); it != batch.end();) {
+    auto source = std::get<0>(*it);
+    linked.clear();
+    packed.clear();
+    reached.clear();
+    for (; it != batch.end() && std::get<0>(*it) == source; ++it) {
+      const auto& [src, dst, w] = *it;
+      if (src->hasEdge(dst, w))
+        continue;
+      this->allocated(1);
+      addToFingerprint(src, dst, w, true);
+      if (journal)
+        journal->edge(Mutation::kInsertEdge, src->getValueRef(), dst->getValueRef(), w);
+      if constexpr (kPacked) {
+        packed.emplace_back(dst->getValueRef(), w);
+        dst->sources.push_back(src->getId());
+      } else {
+        auto edge = edgePool.create(src, dst, w);
+        linked.push_back(edge);
+        dst->addInEdge(edge);
+      }
+      if (reachability)
+        reached.push_back(dst);
+    }
+    if constexpr (kPacked) {
+      source->mergeOutEdges(packed);
+      inserted += packed.size();
+    } else {
+      source->mergeOutEdges(linked);
+      inserted += linked.size();
+    }
+    for (const auto& dst : reached) {
+      reachability->EdgeInserted(source->getId(), dst->getId());
     }
   }
-  source->outEdges.push_back(edge);
-  return true;
+  return inserted;
+}
+
+template <typename N, typename E, typename I>
+gdwg::Graph<N, E, I> gdwg::Graph<N, E, I>::FromEdgeList(
+    const std::vector<std::tuple<N, N, E>>& edges) {
+  Graph<N, E, I> g;
+  g.InsertEdges(edges.begin(), edges.end());
+  return g;
 }
 
 // Deletes node and all corresponding edges
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::DeleteNode(const N& node) {
-  if (nodegraph.find(node) == nodegraph.end())
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::DeleteNode(const N& node) {
+  typename I::Scope scope{*this, GraphOp::kDeleteNode};
+  auto id = idOf(node);
+  if (id == kNoId)
     return false;
 
-  auto del = nodegraph.find(node)->second;
-  // To delete all edges within the node
-  for (const auto& edge : del->outEdges) {
-    erase(edge->getSource(), edge->getDest(), edge->getWeight());
+  auto del = nodesById[id];
+  // Read from del rather than node, which may point into an edge list about to change
+  const auto& val = del->getValueRef();
+  this->scanned(del->degree() + del->inDegree());
+  // Every other node that has an edge to or from del, each only needs one pass
+  std::vector<Node*> sources;
+  std::vector<Node*> dests;
+  for (std::size_t i = 0; i < del->inDegree(); ++i) {
+    auto src = sourceNode(del, i);
+    if (src != del)
+      sources.push_back(src);
+  }
+  for (std::size_t i = 0; i < del->degree(); ++i) {
+    auto dst = destNode(del, i);
+    if (dst != del)
+      dests.push_back(dst);
+  }
+  for (auto list : {&sources, &dests}) {
+    std::sort(list->begin(), list->end());
+    list->erase(std::unique(list->begin(), list->end()), list->end());
+  }
+
+  // Self edges are in both lists, they go with del's out-edges
+  for (const auto& src : sources) {
+    auto [first, last] = src->destRange(val);
+    this->scanned(last - first);
+    for (auto i = first; i < last; ++i) {
+      if (journal)
+        journal->edge(Mutation::kEraseEdge, src->getValueRef(), val, src->weightAt(i));
+      addToFingerprint(src, del, src->weightAt(i), false);
+    }
+    src->removeOutEdgesTo(del);
   }
-  // To delete all edges containing node as destination
-  for (const auto& [key, val] : nodegraph) {
-    for (const auto& edge : val->outEdges) {
-      if (edge->getDest() == node) {
-        erase(edge->getSource(), edge->getDest(), edge->getWeight());
-      }
-      (void)key;
+  for (const auto& dst : dests) {
+    this->scanned(dst->inDegree());
+    dst->removeInEdgesFrom(del);
+  }
+  for (std::size_t i = 0; i < del->degree(); ++i) {
+    if (journal)
+      journal->edge(Mutation::kEraseEdge, val, del->destAt(i), del->weightAt(i));
+    addToFingerprint(del, destNode(del, i), del->weightAt(i), false);
+  }
+  if constexpr (!kPacked) {
+    for (const auto& edge : del->inEdges) {
+      if (edge->getSourceNode() != del)
+        edgePool.destroy(edge);
+    }
+    for (const auto& edge : del->outEdges) {
+      edgePool.destroy(edge);
     }
   }
-  nodegraph.erase(node);
+  if (reachability)
+    reachability->NodeUnlinked(sources, dests);
+  removeNode(id);
   return true;
 }
 
 // Replaces node name with a new name/value
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::Replace(const N& oldData, const N& newData) {
-  if (this->IsNode(newData))
-    return false;
-  if (!this->IsNode(oldData)) {
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::Replace(const N& oldData, const N& newData) {
+  typename I::Scope scope{*this, GraphOp::kReplace};
+  auto id = idOf(oldData);
+  if (id == kNoId) {
     throw std::runtime_error("Cannot call Graph::Replace on a node that doesn't exist");
   }
+  if (this->IsNode(newData))
+    return false;
 
-  std::shared_ptr<Node> replaced = nodegraph[oldData];
-  nodegraph[newData] = replaced;
-  replaced->setValue(newData);
+  Node* replaced = nodesById[id];
+  // Nodes with edges into it, each keeps its out-edges to it in one run
+  std::vector<Node*> sources;
+  for (std::size_t i = 0; i < replaced->inDegree(); ++i) {
+    sources.push_back(sourceNode(replaced, i));
+  }
+  std::sort(sources.begin(), sources.end());
+  sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+  std::vector<std::pair<std::size_t, std::size_t>> runs;
+  for (const auto& source : sources) {
+    runs.push_back(source->destRange(replaced->getValueRef()));
+  }
 
-  for (const auto& [key, val] : nodegraph) {
-    auto nodeEdges = val->outEdges;
-    for (const auto& edge : nodeEdges) {
-      // If destination is the old node
-      if (edge->getDest() == oldData) {
-        // Change the destination of the current edge to be newData instead
-        edge->setDest(nodegraph.find(newData)->second);
+  // Every hash that mixes in the old value has to come out first, self edges only once
+  const auto rehash = [this, replaced, &sources](bool add) {
+    addToFingerprint(replaced, add);
+    for (std::size_t i = 0; i < replaced->degree(); ++i) {
+      addToFingerprint(replaced, destNode(replaced, i), replaced->weightAt(i), add);
+    }
+    for (const auto& source : sources) {
+      if (source == replaced)
+        continue;
+      auto [first, last] = source->destRange(replaced->getValueRef());
+      for (auto i = first; i < last; ++i) {
+        addToFingerprint(source, replaced, source->weightAt(i), add);
       }
     }
-    (void)key;
-  }
-
+  };
+  // oldData may be the renamed node's own value or key, or be in an edge list, so it's done
+  // with before any of them change
+  if (journal)
+    journal->replace(oldData, newData);
+  rehash(false);
+  internTable.erase(oldData);
   nodegraph.erase(oldData);
+  replaced->setValue(newData);
+  nodegraph.emplace(newData, replaced);
+  internTable.emplace(newData, id);
+
+  // Edges hold the node itself or its id, so renaming it is nearly enough. Except that its
+  // sources now have out-edges out of order, and packed ones keep a copy of the old value
+  for (std::size_t k = 0; k < sources.size(); ++k) {
+    this->scanned(sources[k]->degree());
+    sources[k]->renameDest(runs[k].first, runs[k].second, replaced->getValueRef());
+  }
+  rehash(true);
   return true;
 }
 
 // Replaces node with an existing node and transfers it's edges to the new replacement
-template <typename N, typename E>
-void gdwg::Graph<N, E>::MergeReplace(const N& oldData, const N& newData) {
-  if (!this->IsNode(oldData) || !this->IsNode(newData)) {
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::MergeReplace(const N& oldData, const N& newData) {
+  typename I::Scope scope{*this, GraphOp::kMergeReplace};
+  auto oldId = idOf(oldData);
+  auto newId = idOf(newData);
+  if (oldId == kNoId || newId == kNoId) {
     throw std::runtime_error(
         "Cannot call Graph::MergeReplace on old or new data if they don't exist in the graph");
   }
+  if (oldId == newId)
+    return;
+
+  Node* newNode = nodesById[newId];
+  Node* oldNode = nodesById[oldId];
+
+  // Copies, since relinking modifies the lists being walked
+  std::vector<std::pair<Node*, E>> incoming;
+  std::vector<std::pair<Node*, E>> outgoing;
+  std::vector<Node*> sources;
+  for (std::size_t i = 0; i < oldNode->inDegree(); ++i) {
+    // Self edges are moved with the outgoing ones
+    if (sourceNode(oldNode, i) != oldNode)
+      sources.push_back(sourceNode(oldNode, i));
+  }
+  std::sort(sources.begin(), sources.end());
+  sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+  for (const auto& src : sources) {
+    auto [first, last] = src->destRange(oldNode->getValueRef());
+    for (auto i = first; i < last; ++i) {
+      incoming.emplace_back(src, src->weightAt(i));
+    }
+  }
+  for (std::size_t i = 0; i < oldNode->degree(); ++i) {
+    outgoing.emplace_back(destNode(oldNode, i), oldNode->weightAt(i));
+  }
 
-  std::shared_ptr<Node> newNode = nodegraph[newData];
-  std::shared_ptr<Node> oldNode = nodegraph[oldData];
-
-  // Erase node oldData from nodegraph completely
-  // Only instance of node OldData is in the shared pointer above
-
-  for (const auto& edge : oldNode->outEdges) {
-    edge->setDest(newNode);
-    newNode->outEdges.push_back(edge);
+  // Re-home every edge onto newNode, linkEdge drops the ones that become duplicates
+  for (const auto& [src, w] : incoming) {
+    unlinkEdgeAt(src, src->findEdge(oldNode, w));
+    linkEdge(src, newNode, w);
+  }
+  // Relinking never adds to oldNode's out-edges, so the next one is always first
+  for (const auto& [dst, w] : outgoing) {
+    unlinkEdgeAt(oldNode, 0);
+    linkEdge(newNode, dst == oldNode ? newNode : dst, w);
   }
+  removeNode(oldId);
+}
 
-  // Standard iteration through nodegraph
-  for (const auto& [key, val] : nodegraph) {
-    auto nodeEdges = val->outEdges;
-    for (const auto& edge : nodeEdges) {
-      // If destination is the old node
-      if (edge->getDest() == oldData) {
-        // Change the destination of the current edge to be newData instead
-        edge->setDest(newNode);
+// Completely clears the graph of it's nodes and edges
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::Clear() {
+  // Recorded as every edge going and then every node, so it can be undone like the rest
+  if (journal) {
+    for (const auto& [key, val] : nodegraph) {
+      for (std::size_t i = 0; i < val->degree(); ++i) {
+        journal->edge(Mutation::kEraseEdge, key, val->destAt(i), val->weightAt(i));
       }
     }
-
-    // Delete duplicates
-    std::vector<std::shared_ptr<Edge>> seen;
-    for (auto it = std::begin(nodeEdges); it != std::end(nodeEdges); ++it) {
-      auto edgeSeen = val->getEdge((*it)->getDest(), (*it)->getWeight());
-      if (std::find(seen.begin(), seen.end(), edgeSeen) != seen.end()) {
-        this->erase((*it)->getSource(), (*it)->getDest(), (*it)->getWeight());
+    for (const auto& [key, val] : nodegraph) {
+      journal->node(Mutation::kDeleteNode, key);
+      (void)val;
+    }
+  }
+  // Linked edges only need destroying one by one if their weight does, the slabs go all at
+  // once. Packed ones go with their node
+  for (const auto& node : nodesById) {
+    if (node == nullptr)
+      continue;
+    if constexpr (!kPacked && !std::is_trivially_destructible_v<E>) {
+      for (const auto& edge : node->outEdges) {
+        edgePool.destroy(edge);
       }
-      seen.push_back(edgeSeen);
     }
-    (void)key;
+    nodePool.destroy(node);
   }
-  this->DeleteNode(oldData);
-}
-
-// Completely clears the graph of it's nodes and edges
-template <typename N, typename E>
-void gdwg::Graph<N, E>::Clear() {
+  nodePool.release();
+  edgePool.release();
   nodegraph.clear();
+  nodesById.clear();
+  freeIds.clear();
+  internTable.clear();
+  fingerprint = 0;
+  reachability.reset();
 }
 
 // Removes an edge from the graph
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::erase(const N& src, const N& dst, const E& w) {
-  // Source node
-  auto source = nodegraph.find(src)->second;
-  auto found = source->getEdge(dst, w);
-  if (found == nullptr)
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::erase(const N& src, const N& dst, const E& w) {
+  typename I::Scope scope{*this, GraphOp::kErase};
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId)
+    return false;
+  return erase(NodeId{s}, NodeId{d}, w);
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::erase(NodeId src, NodeId dst, const E& w) {
+  typename I::Scope scope{*this, GraphOp::kErase};
+  if (!IsNode(src) || !IsNode(dst))
     return false;
-  // Uses erase-remove idiom (?)
-  source->outEdges.erase(std::remove(source->outEdges.begin(), source->outEdges.end(), found),
-                         source->outEdges.end());
+  auto source = nodesById[src.value];
+  auto pos = source->findEdge(nodesById[dst.value], w);
+  if (pos == source->degree())
+    return false;
+  unlinkEdgeAt(source, pos);
   return true;
 }
 
+// Adds an edge to both of its endpoints unless it already exists
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::linkEdge(Node* src,
+                                    Node* dst,
+                                    const E& w) {
+  // Return false because it already exists
+  if (src->hasEdge(dst, w)) {
+    return false;
+  }
+  this->allocated(1);
+  addToFingerprint(src, dst, w, true);
+  if (journal)
+    journal->edge(Mutation::kInsertEdge, src->getValueRef(), dst->getValueRef(), w);
+  if constexpr (kPacked) {
+    src->insertOutEdge(dst->getValueRef(), w);
+    dst->sources.push_back(src->getId());
+  } else {
+    auto edge = edgePool.create(src, dst, w);
+    src->addOutEdge(edge);
+    dst->addInEdge(edge);
+  }
+  if (reachability)
+    reachability->EdgeInserted(src->getId(), dst->getId());
+  return true;
+}
+
+// Removes an edge from both of its endpoints
+template <typename N, typename E, typename I>
+void gdwg::Graph<N, E, I>::unlinkEdgeAt(Node* src, std::size_t pos) {
+  auto dst = destNode(src, pos);
+  if (journal)
+    journal->edge(Mutation::kEraseEdge, src->getValueRef(), dst->getValueRef(),
+                  src->weightAt(pos));
+  addToFingerprint(src, dst, src->weightAt(pos), false);
+  auto edge = src->eraseOutEdge(pos);
+  if constexpr (kPacked) {
+    this->scanned(dst->removeSource(src->getId()) + 1);
+    (void)edge;
+  } else {
+    dst->removeInEdge(edge);
+    edgePool.destroy(edge);
+  }
+  if (reachability && !src->hasEdgeTo(dst))
+    reachability->EdgeErased(src->getId(), dst->getId());
+}
+
 // Finds all nodes connected between src and dest
-template <typename N, typename E>
-bool gdwg::Graph<N, E>::IsConnected(const N& src, const N& dst) {
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsConnected(const N& src, const N& dst) const {
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId) {
+    throw std::runtime_error(
+        "Cannot call Graph::IsConnected if src or dst node don't exist in the graph");
+  }
+  return nodesById[s]->hasEdgeTo(nodesById[d]);
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsConnected(NodeId src, NodeId dst) const {
   if (!IsNode(src) || !IsNode(dst)) {
     throw std::runtime_error(
         "Cannot call Graph::IsConnected if src or dst node don't exist in the graph");
   }
-  auto source = nodegraph.find(src)->second;
-  for (const auto& edge : source->outEdges) {
-    if ((edge->getSource() == src) && (edge->getDest() == dst))
-      return true;
+  return nodesById[src.value]->hasEdgeTo(nodesById[dst.value]);
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsReachable(const N& src, const N& dst) const {
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId) {
+    throw std::runtime_error(
+        "Cannot call Graph::IsReachable if src or dst node don't exist in the graph");
   }
-  return false;
+  return IsReachable(NodeId{s}, NodeId{d});
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::Graph<N, E, I>::IsReachable(NodeId src, NodeId dst) const {
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::runtime_error(
+        "Cannot call Graph::IsReachable if src or dst node don't exist in the graph");
+  }
+  if (src == dst)
+    return true;
+  if (!reachability)
+    reachability = std::make_unique<detail::ReachabilityIndex<Graph>>(*this);
+  return reachability->Reaches(src.value, dst.value);
 }
 
 // Creates a vector containing all nodes in the DG
-template <typename N, typename E>
-std::vector<N> gdwg::Graph<N, E>::GetNodes(void) const {
+template <typename N, typename E, typename I>
+std::vector<N> gdwg::Graph<N, E, I>::GetNodes(void) const {
+  // nodegraph is ordered, so no need to sort
   std::vector<N> ret;
+  ret.reserve(nodegraph.size());
   for (const auto& it : nodegraph) {
     ret.push_back(it.first);
   }
-  sort(ret.begin(), ret.end());
   return ret;
 }
 
 // Creates a vector containing all edges the node contains
-template <typename N, typename E>
-std::vector<N> gdwg::Graph<N, E>::GetConnected(const N& src) const {
-  if (nodegraph.find(src) == nodegraph.end()) {
+template <typename N, typename E, typename I>
+std::vector<N> gdwg::Graph<N, E, I>::GetConnected(const N& src) const {
+  auto s = idOf(src);
+  if (s == kNoId) {
     throw std::out_of_range("Cannot call Graph::GetConnected if src doesn't exist in the graph");
   }
-  std::vector<N> ret;
-  auto source = nodegraph.find(src)->second;
-  for (const auto& edge : source->outEdges) {
-    auto connected = edge->getDest();
-    ret.push_back(connected);
+  return GetConnected(NodeId{s});
+}
+
+template <typename N, typename E, typename I>
+std::vector<N> gdwg::Graph<N, E, I>::GetConnected(NodeId src) const {
+  if (!IsNode(src)) {
+    throw std::out_of_range("Cannot call Graph::GetConnected if src doesn't exist in the graph");
   }
-  sort(ret.begin(), ret.end());
-  return ret;
+  // Already in order, since out-edges are sorted by destination
+  auto view = Neighbors(src);
+  return std::vector<N>(view.begin(), view.end());
 }
 
 // Creates a vector containing all edges/weights that connects src and dst
-template <typename N, typename E>
-std::vector<E> gdwg::Graph<N, E>::GetWeights(const N& src, const N& dst) const {
-  if (nodegraph.find(src) == nodegraph.end() || nodegraph.find(dst) == nodegraph.end()) {
+template <typename N, typename E, typename I>
+std::vector<E> gdwg::Graph<N, E, I>::GetWeights(const N& src, const N& dst) const {
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId) {
     throw std::out_of_range(
         "Cannot call Graph::GetWeights if src or dst node don't exist in the graph");
   }
-  std::vector<E> ret;
-  auto source = nodegraph.find(src)->second;
-  for (const auto& edge : source->outEdges) {
-    if (edge->getDest() == dst) {
-      ret.push_back(edge->getWeight());
-    }
+  return GetWeights(NodeId{s}, NodeId{d});
+}
+
+template <typename N, typename E, typename I>
+std::vector<E> gdwg::Graph<N, E, I>::GetWeights(NodeId src, NodeId dst) const {
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::out_of_range(
+        "Cannot call Graph::GetWeights if src or dst node don't exist in the graph");
   }
-  sort(ret.begin(), ret.end());
-  return ret;
+  auto view = Weights(src, dst);
+  return std::vector<E>(view.begin(), view.end());
 }
 
-// Edge function, shows dest
-template <typename N, typename E>
-N gdwg::Graph<N, E>::Edge::getDest() const {
-  std::shared_ptr<Node> tmp = destination.lock();
-  return tmp->getValue();
+// Views over src's out-edges
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::NeighborView gdwg::Graph<N, E, I>::Neighbors(const N& src) const {
+  auto s = idOf(src);
+  if (s == kNoId) {
+    throw std::out_of_range("Cannot call Graph::Neighbors if src doesn't exist in the graph");
+  }
+  return Neighbors(NodeId{s});
 }
 
-// Edge function, shows source
-template <typename N, typename E>
-N gdwg::Graph<N, E>::Edge::getSource() const {
-  std::shared_ptr<Node> tmp = source.lock();
-  return tmp->getValue();
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::NeighborView gdwg::Graph<N, E, I>::Neighbors(NodeId src) const {
+  if (!IsNode(src)) {
+    throw std::out_of_range("Cannot call Graph::Neighbors if src doesn't exist in the graph");
+  }
+  const auto node = nodesById[src.value];
+  return NeighborView{node, 0, node->degree()};
 }
 
-// Iterator related functions
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::WeightView gdwg::Graph<N, E, I>::Weights(const N& src,
+                                                                        const N& dst) const {
+  auto s = idOf(src);
+  auto d = idOf(dst);
+  if (s == kNoId || d == kNoId) {
+    throw std::out_of_range(
+        "Cannot call Graph::Weights if src or dst node don't exist in the graph");
+  }
+  return Weights(NodeId{s}, NodeId{d});
+}
 
-// in graph
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator const
-gdwg::Graph<N, E>::find(const N& source, const N& dest, const E& weight) {
-  auto it = begin();
-  for (; it != end(); ++it) {
-    auto tuple = *it;
-    if (std::get<0>(tuple) == source && std::get<1>(tuple) == dest && std::get<2>(tuple) == weight)
-      return it;
-  }
-  return it;
-}
-
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::erase(const_iterator it) {
-  if (it != end()) {
-    auto oldSource = std::get<0>(*it);
-    auto oldDest = std::get<1>(*it);
-    auto oldWeight = std::get<2>(*it);
-    ++it;
-    if (erase(oldSource, oldDest, oldWeight) == false)
-      it = end();
-    return it;
+template <typename N, typename E, typename I>
+typename
+gdwg::Graph<N, E, I>::WeightView gdwg::Graph<N, E, I>::Weights(NodeId src, NodeId dst) const {
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::out_of_range(
+        "Cannot call Graph::Weights if src or dst node don't exist in the graph");
   }
-  return end();
+  const auto node = nodesById[src.value];
+  auto [first, last] = node->destRange(nodesById[dst.value]->getValueRef());
+  return WeightView{node, first, last};
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::OutEdgeView gdwg::Graph<N, E, I>::OutEdges(const N& src) const {
+  auto s = idOf(src);
+  if (s == kNoId) {
+    throw std::out_of_range("Cannot call Graph::OutEdges if src doesn't exist in the graph");
+  }
+  return OutEdges(NodeId{s});
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::OutEdgeView gdwg::Graph<N, E, I>::OutEdges(NodeId src) const {
+  if (!IsNode(src)) {
+    throw std::out_of_range("Cannot call Graph::OutEdges if src doesn't exist in the graph");
+  }
+  const auto node = nodesById[src.value];
+  return OutEdgeView{node, 0, node->degree()};
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator const gdwg::Graph<N, E>::cbegin() {
+// Looks up the id of a node
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::NodeId gdwg::Graph<N, E, I>::GetId(const N& val) const {
+  auto id = idOf(val);
+  if (id == kNoId) {
+    throw std::out_of_range("Cannot call Graph::GetId if val doesn't exist in the graph");
+  }
+  return NodeId{id};
+}
+
+// Looks up the value of a node id
+template <typename N, typename E, typename I>
+const N& gdwg::Graph<N, E, I>::GetValue(NodeId id) const {
+  if (!IsNode(id)) {
+    throw std::out_of_range("Cannot call Graph::GetValue if id doesn't exist in the graph");
+  }
+  return nodesById[id.value]->getValueRef();
+}
+
+// Iterator related functions
+
+// Looks the source up in nodegraph, then binary searches its out-edges
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator const
+gdwg::Graph<N, E, I>::find(const N& source, const N& dest, const E& weight) {
+  typename I::Scope scope{*this, GraphOp::kFind};
+  auto node_it = nodegraph.find(source);
+  if (node_it == nodegraph.end())
+    return end();
+  const auto node = node_it->second;
+  auto pos = node->lowerBound(dest, weight);
+  if (pos == node->degree() || node->destAt(pos) != dest || node->weightAt(pos) != weight)
+    return end();
+  return const_iterator{this, node_it, nodegraph.end(), pos};
+}
+
+// Removes the edge it points at directly, rather than looking it up again by value
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::erase(const_iterator it) {
+  typename I::Scope scope{*this, GraphOp::kErase};
+  if (it == end())
+    return end();
+  auto node_it = it.node_it_;
+  unlinkEdgeAt(node_it->second, it.edge_);
+  if (it.edge_ < node_it->second->degree())
+    return const_iterator{this, node_it, nodegraph.end(), it.edge_};
+  // That was the node's last edge, carry on from the next node that has any
+  do {
+    ++node_it;
+  } while (node_it != nodegraph.end() && node_it->second->empty());
+  if (node_it == nodegraph.end())
+    return end();
+  return const_iterator{this, node_it, nodegraph.end(), 0};
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::cbegin() const {
   return begin();
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator const gdwg::Graph<N, E>::cend() {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::cend() const {
   return end();
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator const gdwg::Graph<N, E>::crbegin() {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::crbegin() const {
   return rbegin();
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator const gdwg::Graph<N, E>::crend() {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::crend() const {
   return rend();
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator const gdwg::Graph<N, E>::begin() {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::begin() const {
   // What if the first element is empty?
-  if (auto first = std::find_if(
-          nodegraph.begin(), nodegraph.end(),
-          [](const std::pair<N, std::shared_ptr<Node>>& s) { return !((s.second)->empty()); });
+  if (auto first = std::find_if(nodegraph.begin(), nodegraph.end(),
+                                [](const auto& s) { return !((s.second)->empty()); });
       first != nodegraph.end()) {
-    return const_iterator{first, nodegraph.end(), first->second->begin()};
+    return const_iterator{this, first, nodegraph.end(), 0};
   }
   return end();
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator const gdwg::Graph<N, E>::end() {
-  return const_iterator{nodegraph.end(), nodegraph.end(), {}};
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::end() const {
+  return const_iterator{this, nodegraph.end(), nodegraph.end(), 0};
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator const gdwg::Graph<N, E>::rbegin() {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::rbegin() const {
   // What if the first element is empty?
-  if (auto first = std::find_if(
-          nodegraph.rbegin(), nodegraph.rend(),
-          [](const std::pair<N, std::shared_ptr<Node>>& s) { return !((s.second)->empty()); });
+  if (auto first = std::find_if(nodegraph.rbegin(), nodegraph.rend(),
+                                [](const auto& s) { return !((s.second)->empty()); });
       first != nodegraph.rend()) {
-    return const_reverse_iterator{first, nodegraph.rend(), first->second->rbegin()};
+    return const_reverse_iterator{this, first, nodegraph.rend(), first->second->degree()};
   }
   return rend();
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator const gdwg::Graph<N, E>::rend() {
-  return const_reverse_iterator{nodegraph.rend(), nodegraph.rend(), {}};
-}
-
-// in node
-template <typename N, typename E>
-N& gdwg::Graph<N, E>::Node::getValueRef() {
-  return value;
-}
-
-// in edge
-template <typename N, typename E>
-E& gdwg::Graph<N, E>::Edge::getWeightRef() {
-  return weight;
-}
-
-template <typename N, typename E>
-N& gdwg::Graph<N, E>::Edge::getSourceRef() {
-  std::shared_ptr<Node> tmp = source.lock();
-  return tmp->getValueRef();
-}
-
-template <typename N, typename E>
-N& gdwg::Graph<N, E>::Edge::getDestRef() {
-  std::shared_ptr<Node> tmp = destination.lock();
-  return tmp->getValueRef();
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::rend() const {
+  return const_reverse_iterator{this, nodegraph.rend(), nodegraph.rend(), 0};
 }
 
 // Iterator functions
 
 //*, ++, --, == and !=
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator::reference gdwg::Graph<N, E>::const_iterator::
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator::reference gdwg::Graph<N, E, I>::const_iterator::
 operator*() const {
-  return {edge_it_->get()->getSourceRef(), edge_it_->get()->getDestRef(),
-          edge_it_->get()->getWeightRef()};
+  const auto node = node_it_->second;
+  return {node->getValueRef(), node->destAt(edge_), node->weightAt(edge_)};
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::const_iterator::operator++() {
-  ++edge_it_;
-  if (edge_it_ == node_it_->second->end()) {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::const_iterator::operator++() {
+  this->stepped();
+  ++edge_;
+  if (edge_ == node_it_->second->degree()) {
     do {
       ++node_it_;
-    } while (node_it_ != sentinel_ && node_it_->second->begin() == node_it_->second->end());
-    if (node_it_ != sentinel_) {
-      edge_it_ = node_it_->second->begin();
-    }
+    } while (node_it_ != sentinel_ && node_it_->second->empty());
+    edge_ = 0;
   }
   return *this;
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::const_iterator::operator++(int) {
+template <typename N, typename E, typename I>
+typename
+gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::const_iterator::operator++(int) {
   auto copy{*this};
   ++(*this);
   return copy;
 }
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::const_iterator::operator--() {
-  if (node_it_ == sentinel_) {
-    do {
-      --node_it_;
-      edge_it_ = node_it_->second->begin();
-    } while (node_it_->second->begin() == node_it_->second->end());
-    while (edge_it_ != node_it_->second->end())
-      ++edge_it_;
-    --edge_it_;  // 1 before the end
-    return *this;
-  }
-  if (edge_it_ == node_it_->second->begin()) {
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::const_iterator::operator--() {
+  this->stepped();
+  if (node_it_ == sentinel_ || edge_ == 0) {
     do {
       --node_it_;
-      edge_it_ = node_it_->second->begin();
-    } while (node_it_->second->begin() == node_it_->second->end());
-    while (edge_it_ != node_it_->second->end())
-      ++edge_it_;
-    --edge_it_;  // 1 before the end
+    } while (node_it_->second->empty());
+    edge_ = node_it_->second->degree() - 1;  // 1 before the end
     return *this;
   }
   // case for internally going back
-  --edge_it_;
+  --edge_;
   return *this;
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::const_iterator::operator--(int) {
+template <typename N, typename E, typename I>
+typename
+gdwg::Graph<N, E, I>::const_iterator gdwg::Graph<N, E, I>::const_iterator::operator--(int) {
   auto copy{*this};
   --(*this);
   return copy;
@@ -471,66 +899,55 @@ typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::const_iterator::op
 // reverse iterator functions
 
 //*, ++, --, == and !=
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator::reference
-    gdwg::Graph<N, E>::const_reverse_iterator::operator*() const {
-  return {edge_it_->get()->getSourceRef(), edge_it_->get()->getDestRef(),
-          edge_it_->get()->getWeightRef()};
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator::reference
+    gdwg::Graph<N, E, I>::const_reverse_iterator::operator*() const {
+  const auto node = node_it_->second;
+  return {node->getValueRef(), node->destAt(edge_ - 1), node->weightAt(edge_ - 1)};
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator gdwg::Graph<N, E>::const_reverse_iterator::
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::const_reverse_iterator::
 operator++() {
-  ++edge_it_;
-  if (edge_it_ == node_it_->second->rend()) {
+  this->stepped();
+  --edge_;
+  if (edge_ == 0) {
     do {
       ++node_it_;
-    } while (node_it_ != sentinel_ && node_it_->second->rbegin() == node_it_->second->rend());
+    } while (node_it_ != sentinel_ && node_it_->second->empty());
     if (node_it_ != sentinel_) {
-      edge_it_ = node_it_->second->rbegin();
+      edge_ = node_it_->second->degree();
     }
   }
   return *this;
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator gdwg::Graph<N, E>::const_reverse_iterator::
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::const_reverse_iterator::
 operator++(int) {
   auto copy{*this};
   ++(*this);
   return copy;
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator gdwg::Graph<N, E>::const_reverse_iterator::
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::const_reverse_iterator::
 operator--() {
-  if (node_it_ == sentinel_) {
-    do {
-      --node_it_;
-      edge_it_ = node_it_->second->rbegin();
-    } while (node_it_->second->rbegin() == node_it_->second->rend());
-    while (edge_it_ != node_it_->second->rend())
-      ++edge_it_;
-    --edge_it_;  // 1 before the end
-    return *this;
-  }
-  if (edge_it_ == node_it_->second->rbegin()) {
+  this->stepped();
+  if (node_it_ == sentinel_ || edge_ == node_it_->second->degree()) {
     do {
       --node_it_;
-      edge_it_ = node_it_->second->rbegin();
-    } while (node_it_->second->rbegin() == node_it_->second->rend());
-    while (edge_it_ != node_it_->second->rend())
-      ++edge_it_;
-    --edge_it_;  // 1 before the end
+    } while (node_it_->second->empty());
+    edge_ = 1;  // 1 before the end
     return *this;
   }
   // case for internally going back
-  --edge_it_;
+  ++edge_;
   return *this;
 }
 
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_reverse_iterator gdwg::Graph<N, E>::const_reverse_iterator::
+template <typename N, typename E, typename I>
+typename gdwg::Graph<N, E, I>::const_reverse_iterator gdwg::Graph<N, E, I>::const_reverse_iterator::
 operator--(int) {
   auto copy{*this};
   --(*this);
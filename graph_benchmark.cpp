@@ -0,0 +1,218 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/concurrent_graph.h"
+#include "assignments/dg/graph.h"
+
+// Times the core Graph operations on generated graphs and prints one CSV row per
+// measurement, so runs can be diffed or loaded into a spreadsheet.
+//
+// Usage: graph_benchmark [max edges, default 1000000]
+// Graphs go from 1K edges up to max edges in steps of 10x, in three shapes:
+// - uniform: every endpoint picked uniformly
+// - powerlaw: destinations skewed so a few nodes get most of the edges
+// - dense: few enough nodes that most pairs are connected
+
+namespace {
+
+// Keeps results alive so the optimiser can't drop the work being timed
+volatile std::size_t sink;
+
+template <typename T>
+T makeValue(std::size_t i);
+
+template <>
+int makeValue<int>(std::size_t i) {
+  return static_cast<int>(i);
+}
+
+template <>
+double makeValue<double>(std::size_t i) {
+  return static_cast<double>(i % 1000) / 4;
+}
+
+template <>
+std::string makeValue<std::string>(std::size_t i) {
+  // Long enough to not fit in the small string buffer
+  return "node-with-a-long-name-" + std::to_string(i);
+}
+
+// Node count and (src, dst, weight) indices of a generated graph
+struct Shape {
+  std::string name;
+  std::size_t nodes;
+  std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> edges;
+};
+
+Shape generate(const std::string& name, std::size_t edges) {
+  std::mt19937_64 rng{edges};
+  std::uniform_real_distribution<double> unit{0, 1};
+  Shape shape{name, 0, {}};
+  if (name == "dense") {
+    shape.nodes = static_cast<std::size_t>(std::sqrt(static_cast<double>(edges))) + 1;
+  } else {
+    shape.nodes = std::max<std::size_t>(edges / 8, 2);
+  }
+  std::uniform_int_distribution<std::size_t> pick{0, shape.nodes - 1};
+  shape.edges.reserve(edges);
+  for (std::size_t e = 0; e < edges; ++e) {
+    auto src = pick(rng);
+    auto dst = pick(rng);
+    if (name == "powerlaw") {
+      // Cubing a uniform value piles most of the picks onto the first few nodes
+      auto u = unit(rng);
+      dst = static_cast<std::size_t>(u * u * u * static_cast<double>(shape.nodes - 1));
+    }
+    shape.edges.emplace_back(src, dst, e % 7);
+  }
+  return shape;
+}
+
+template <typename F>
+double timeIt(F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string& types,
+            const Shape& shape,
+            const std::string& operation,
+            std::size_t ops,
+            double seconds) {
+  std::cout << types << ',' << shape.name << ',' << shape.nodes << ',' << shape.edges.size()
+            << ',' << operation << ',' << ops << ',' << seconds << ','
+            << (ops > 0 ? seconds * 1e9 / static_cast<double>(ops) : 0) << '\n';
+}
+
+template <typename N, typename E>
+void benchmark(const std::string& types, const Shape& shape) {
+  std::vector<N> nodes;
+  nodes.reserve(shape.nodes);
+  for (std::size_t i = 0; i < shape.nodes; ++i) {
+    nodes.push_back(makeValue<N>(i));
+  }
+  // Queries only look at a sample, so the biggest graphs don't take minutes per operation
+  const std::size_t samples = std::min<std::size_t>(shape.edges.size(), 100000);
+  const std::size_t mutations = std::min<std::size_t>(shape.nodes / 2, 1000);
+
+  gdwg::Graph<N, E> g;
+  report(types, shape, "InsertNode", nodes.size(), timeIt([&] {
+           for (const auto& node : nodes) {
+             g.InsertNode(node);
+           }
+         }));
+  report(types, shape, "InsertEdge", shape.edges.size(), timeIt([&] {
+           for (const auto& [src, dst, w] : shape.edges) {
+             g.InsertEdge(nodes[src], nodes[dst], makeValue<E>(w));
+           }
+         }));
+
+  report(types, shape, "GetConnected", nodes.size(), timeIt([&] {
+           std::size_t total = 0;
+           for (const auto& node : nodes) {
+             total += g.GetConnected(node).size();
+           }
+           sink = total;
+         }));
+  report(types, shape, "GetWeights", samples, timeIt([&] {
+           std::size_t total = 0;
+           for (std::size_t i = 0; i < samples; ++i) {
+             const auto& [src, dst, w] = shape.edges[i];
+             total += g.GetWeights(nodes[src], nodes[dst]).size();
+           }
+           sink = total;
+         }));
+  report(types, shape, "find", samples, timeIt([&] {
+           std::size_t total = 0;
+           for (std::size_t i = 0; i < samples; ++i) {
+             const auto& [src, dst, w] = shape.edges[i];
+             total += g.find(nodes[src], nodes[dst], makeValue<E>(w)) != g.end();
+           }
+           sink = total;
+         }));
+  std::size_t edges = 0;
+  report(types, shape, "iterate", shape.edges.size(), timeIt([&] {
+           for (auto it = g.cbegin(); it != g.cend(); ++it) {
+             ++edges;
+           }
+           sink = edges;
+         }));
+
+  gdwg::Graph<N, E> copy;
+  report(types, shape, "copy", edges, timeIt([&] { copy = gdwg::Graph<N, E>{g}; }));
+  report(types, shape, "operator==", edges, timeIt([&] { sink = (copy == g); }));
+
+  // Each mutation runs on its own copy, so they all start from the same graph
+  copy = g;
+  report(types, shape, "Replace", mutations, timeIt([&] {
+           for (std::size_t i = 0; i < mutations; ++i) {
+             copy.Replace(nodes[i], makeValue<N>(shape.nodes + i));
+           }
+         }));
+  copy = g;
+  report(types, shape, "MergeReplace", mutations, timeIt([&] {
+           for (std::size_t i = 0; i < mutations; ++i) {
+             copy.MergeReplace(nodes[i], nodes[nodes.size() - 1 - i]);
+           }
+         }));
+  copy = g;
+  report(types, shape, "DeleteNode", mutations, timeIt([&] {
+           for (std::size_t i = 0; i < mutations; ++i) {
+             copy.DeleteNode(nodes[i]);
+           }
+         }));
+
+  // Readers each take a snapshot and look an edge up in it, while a writer keeps publishing.
+  // Reads share nothing, so ns_per_op, wall time over every reader's reads, should fall as
+  // readers are added
+  gdwg::ConcurrentGraph<N, E> shared{g};
+  for (unsigned readers : {1u, 2u, 4u, 8u}) {
+    std::atomic<bool> done{false};
+    std::thread writer{[&] {
+      while (!done.load()) {
+        shared.Update([&](gdwg::Graph<N, E>& graph) { graph.InsertNode(nodes[0]); });
+      }
+    }};
+    report(types, shape, "Read x" + std::to_string(readers), readers * samples, timeIt([&] {
+             std::vector<std::thread> threads;
+             for (unsigned r = 0; r < readers; ++r) {
+               threads.emplace_back([&] {
+                 std::size_t total = 0;
+                 for (std::size_t i = 0; i < samples; ++i) {
+                   const auto& [src, dst, w] = shape.edges[i];
+                   total += shared.Read()->IsConnected(nodes[src], nodes[dst]);
+                 }
+                 sink = total;
+               });
+             }
+             for (auto& thread : threads) {
+               thread.join();
+             }
+           }));
+    done = true;
+    writer.join();
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t maxEdges = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::cout << "types,shape,nodes,edges,operation,ops,seconds,ns_per_op\n";
+  for (std::size_t edges = 1000; edges <= maxEdges; edges *= 10) {
+    for (const auto& name : {"uniform", "powerlaw", "dense"}) {
+      auto shape = generate(name, edges);
+      benchmark<int, int>("int/int", shape);
+      benchmark<std::string, double>("string/double", shape);
+    }
+  }
+}
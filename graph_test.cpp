@@ -76,6 +76,17 @@ SCENARIO("Testing Directed Graph (DG) Constructors") {
       }
     }
   }
+  GIVEN("A tuple const iterator range that repeats an edge") {
+    auto e = std::vector<std::tuple<std::string, std::string, double>>{
+        {"how", "are", 7.6}, {"Hello", "how", 5.4}, {"how", "are", 7.6}};
+    WHEN("The DG is initialised with the above") {
+      gdwg::Graph<std::string, double> dg{e.begin(), e.end()};
+      THEN("The repeated edge is only inserted once, like InsertEdge") {
+        REQUIRE(dg.GetWeights("how", "are") == std::vector<double>{7.6});
+        REQUIRE(dg.GetConnected("Hello") == std::vector<std::string>{"how"});
+      }
+    }
+  }
   GIVEN("An initialiser vector of elements of type N") {
     gdwg::Graph<char, std::string> dg{'a', 'b', 'x', 'y'};
     WHEN("The DG is initialised with the above") {
@@ -106,6 +117,28 @@ SCENARIO("Testing Directed Graph (DG) Constructors") {
       }
     }
   }
+  GIVEN("A const DG with edges") {
+    gdwg::Graph<char, std::string> orig{'a', 'b', 'x', 'y'};
+    orig.InsertEdge('a', 'b', "five");
+    orig.InsertEdge('b', 'a', "six");
+    orig.InsertEdge('b', 'b', "seven");
+    orig.DeleteNode('x');
+    const auto& dg = orig;
+    WHEN("A DG is copy constructed") {
+      gdwg::Graph<char, std::string> dgCopy{dg};
+      THEN("The copy has the same nodes, edges and ids, and is independent of the old DG") {
+        REQUIRE(dgCopy == dg);
+        REQUIRE(dgCopy.GetId('y') == dg.GetId('y'));
+        REQUIRE(dgCopy.IdBound() == dg.IdBound());
+        dgCopy.DeleteNode('a');
+        dgCopy.InsertNode('z');
+        REQUIRE(dg.GetWeights('b', 'a') == std::vector<std::string>{"six"});
+        REQUIRE(dg.GetConnected('b') == std::vector<char>{'a', 'b'});
+        REQUIRE(!dg.IsNode('z'));
+        REQUIRE(dgCopy.GetConnected('b') == std::vector<char>{'b'});
+      }
+    }
+  }
   GIVEN("An already-constructed DG") {
     gdwg::Graph<char, std::string> dg{'a', 'b', 'x', 'y'};
     WHEN("A DG is move constructed") {
@@ -145,6 +178,16 @@ SCENARIO("Testing DG Operations") {
         REQUIRE(dg.IsNode('y'));
       }
     }
+    WHEN("A DG is move-assigned over a DG that already has edges") {
+      gdwg::Graph<char, std::string> other{'p', 'q'};
+      other.InsertEdge('p', 'q', "five");
+      other = std::move(dg);
+      THEN("The old nodes and edges are gone and the moved-from DG is empty") {
+        REQUIRE(other.GetNodes() == std::vector<char>{'a', 'b', 'x', 'y'});
+        REQUIRE(other.begin() == other.end());
+        REQUIRE(dg.GetNodes().empty());
+      }
+    }
     WHEN("A DG is move-assigned to the old DG") {
       auto dgMove{std::move(dg)};
       THEN("The DG should not contain any of it's old elements and should now"
@@ -189,6 +232,52 @@ SCENARIO("Testing DG Friends") {
       THEN("It should return false") { REQUIRE(res == false); }
     }
   }
+  GIVEN("Two graphs with the same nodes built in different orders") {
+    gdwg::Graph<char, std::string> dg{'a', 'b', 'x'};
+    gdwg::Graph<char, std::string> dg1{'x', 'b', 'a'};
+    dg.InsertEdge('a', 'b', "one");
+    dg.InsertEdge('a', 'x', "two");
+    dg1.InsertEdge('a', 'x', "two");
+    dg1.InsertEdge('a', 'b', "one");
+    WHEN("They are compared") {
+      THEN("They are equal and have the same fingerprint") {
+        REQUIRE(dg == dg1);
+        REQUIRE(dg.Fingerprint() == dg1.Fingerprint());
+      }
+    }
+    WHEN("Only an edge's weight or direction differs") {
+      gdwg::Graph<char, std::string> weight{dg};
+      gdwg::Graph<char, std::string> direction{dg};
+      weight.erase('a', 'b', "one");
+      weight.InsertEdge('a', 'b', "three");
+      direction.erase('a', 'b', "one");
+      direction.InsertEdge('b', 'a', "one");
+      THEN("They are no longer equal") {
+        REQUIRE(dg != weight);
+        REQUIRE(dg != direction);
+        REQUIRE(dg.Fingerprint() != direction.Fingerprint());
+      }
+    }
+    WHEN("A node is replaced and then replaced back") {
+      dg.InsertEdge('b', 'b', "self");
+      dg1.InsertEdge('b', 'b', "self");
+      dg.Replace('b', 'c');
+      bool replaced = (dg == dg1);
+      dg.Replace('c', 'b');
+      THEN("The graphs differ in between and are equal again after") {
+        REQUIRE(replaced == false);
+        REQUIRE(dg == dg1);
+        REQUIRE(dg.Fingerprint() == dg1.Fingerprint());
+      }
+    }
+    WHEN("One of them is moved from") {
+      gdwg::Graph<char, std::string> moved{std::move(dg1)};
+      THEN("The moved-from graph equals an empty graph") {
+        REQUIRE(moved == dg);
+        REQUIRE(dg1 == gdwg::Graph<char, std::string>{});
+      }
+    }
+  }
 }
 
 SCENARIO("Testing DG Methods") {
@@ -285,6 +374,83 @@ SCENARIO("Testing DG Methods") {
         REQUIRE(dg.IsConnected('b', 'b') == true);
       }
     }
+    WHEN("A node with incoming and outgoing edges is deleted") {
+      dg.InsertEdge('a', 'b', "five");
+      dg.InsertEdge('b', 'x', "six");
+      dg.InsertEdge('x', 'b', "seven");
+      dg.InsertEdge('b', 'b', "eight");
+      dg.DeleteNode('b');
+      THEN("Only the edges touching it are removed from its neighbours") {
+        REQUIRE(dg.GetConnected('a').empty());
+        REQUIRE(dg.GetConnected('x').empty());
+        REQUIRE(dg.begin() == dg.end());
+      }
+    }
+    WHEN("A node is merge-replaced into a node it shares edges with") {
+      dg.InsertEdge('a', 'x', "five");
+      dg.InsertEdge('b', 'x', "five");
+      dg.InsertEdge('y', 'a', "six");
+      dg.InsertEdge('y', 'b', "six");
+      dg.InsertEdge('a', 'a', "seven");
+      dg.MergeReplace('a', 'b');
+      THEN("Edges in and out of it are moved to the new node without duplicates") {
+        REQUIRE(dg.GetWeights('b', 'x') == std::vector<std::string>{"five"});
+        REQUIRE(dg.GetWeights('y', 'b') == std::vector<std::string>{"six"});
+        REQUIRE(dg.GetWeights('b', 'b') == std::vector<std::string>{"seven"});
+        int edges = 0;
+        for (auto it = dg.begin(); it != dg.end(); ++it) {
+          REQUIRE(std::get<0>(*it) != 'a');
+          REQUIRE(std::get<1>(*it) != 'a');
+          ++edges;
+        }
+        REQUIRE(edges == 3);
+        gdwg::Graph<char, std::string> expected{'b', 'x', 'y'};
+        expected.InsertEdge('b', 'x', "five");
+        expected.InsertEdge('y', 'b', "six");
+        expected.InsertEdge('b', 'b', "seven");
+        REQUIRE(dg == expected);
+      }
+    }
+    WHEN("A hub node with a self edge is merge-replaced") {
+      gdwg::Graph<int, int> hub;
+      const int size = static_cast<int>(gdwg::Graph<int, int>::Node::kEdgeIndexThreshold) * 2;
+      for (int i = 0; i <= size; ++i) {
+        hub.InsertNode(i);
+      }
+      for (int i = 1; i <= size; ++i) {
+        hub.InsertEdge(0, i, i);
+        hub.InsertEdge(i, 0, i);
+      }
+      hub.InsertEdge(0, 0, 0);
+      hub.MergeReplace(0, 1);
+      THEN("Every edge ends up on the new node, including the self edge") {
+        REQUIRE(!hub.IsNode(0));
+        REQUIRE(hub.GetWeights(1, 1) == std::vector<int>{0, 1});
+        REQUIRE(hub.GetConnected(1).size() == static_cast<std::size_t>(size + 1));
+        REQUIRE(hub.GetConnected(size) == std::vector<int>{1});
+      }
+    }
+    WHEN("A node's adjacency is read through views") {
+      dg.InsertEdge('b', 'y', "two");
+      dg.InsertEdge('b', 'a', "one");
+      dg.InsertEdge('b', 'y', "three");
+      auto neighbors = dg.Neighbors('b');
+      auto weights = dg.Weights('b', 'y');
+      auto out = dg.OutEdges('b');
+      THEN("They hold the same values as the vector versions, in order, read in place") {
+        REQUIRE(std::vector<char>(neighbors.begin(), neighbors.end()) == dg.GetConnected('b'));
+        REQUIRE(std::vector<std::string>(weights.begin(), weights.end()) ==
+                dg.GetWeights('b', 'y'));
+        REQUIRE(neighbors.size() == 3);
+        REQUIRE(&weights.front() == &std::get<1>(out[1]));
+        REQUIRE(out[0] == std::make_tuple('a', "one"));
+        REQUIRE(out.back() == std::make_tuple('y', "two"));
+        REQUIRE(dg.Weights('a', 'b').empty());
+        REQUIRE(dg.Neighbors(dg.GetId('b')).front() == 'a');
+        REQUIRE_THROWS_AS(dg.Neighbors('z'), std::out_of_range);
+        REQUIRE_THROWS_AS(dg.Weights('b', 'z'), std::out_of_range);
+      }
+    }
     WHEN("A node is merge-replaced by a pre-existing node but either the source or"
          "the destination does not exist") {
       THEN("No changes are made to the graph and a runtime_error exception is thrown") {
@@ -302,6 +468,17 @@ SCENARIO("Testing DG Methods") {
         REQUIRE(!dg.IsNode('y'));
       }
     }
+    WHEN("The graph is cleared using Clear() and then reused") {
+      dg.InsertEdge('a', 'b', "five");
+      dg.InsertEdge('b', 'b', "six");
+      dg.Clear();
+      dg.InsertNode('q');
+      dg.InsertEdge('q', 'q', "seven");
+      THEN("Only the new nodes and edges exist") {
+        REQUIRE(dg.GetNodes() == std::vector<char>{'q'});
+        REQUIRE(dg.GetWeights('q', 'q') == std::vector<std::string>{"seven"});
+      }
+    }
     WHEN("An existing node is tested for it's existence using IsNode()") {
       bool res = dg.IsNode('a');
       THEN("The result is true") { REQUIRE(res == true); }
@@ -372,6 +549,143 @@ SCENARIO("Testing DG Methods") {
       THEN("Nothing happens to the graph and erase() returns false") { REQUIRE(res == false); }
     }
   }
+  GIVEN("A DG that edges are bulk loaded into") {
+    gdwg::Graph<std::string, int> g{"hello", "how"};
+    g.InsertEdge("hello", "how", 5);
+    WHEN("A batch with new nodes, repeats and existing edges is inserted") {
+      auto inserted = g.InsertEdges({{"you", "hello", 2},
+                                     {"hello", "how", 5},
+                                     {"hello", "are", 1},
+                                     {"you", "hello", 2},
+                                     {"hello", "how", 3}});
+      THEN("Only new edges are added and every list stays in order") {
+        REQUIRE(inserted == 3);
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"are", "hello", "how", "you"});
+        REQUIRE(g.GetConnected("hello") == std::vector<std::string>{"are", "how", "how"});
+        REQUIRE(g.GetWeights("hello", "how") == std::vector<int>{3, 5});
+        REQUIRE(g.GetWeights("you", "hello") == std::vector<int>{2});
+        REQUIRE(*g.begin() == std::make_tuple("hello", "are", 1));
+      }
+    }
+    WHEN("A graph is built with FromEdgeList") {
+      auto built = gdwg::Graph<std::string, int>::FromEdgeList(
+          {{"hello", "how", 5}, {"how", "hello", 4}, {"hello", "how", 5}});
+      THEN("It equals the same graph built edge by edge") {
+        gdwg::Graph<std::string, int> expected{"hello", "how"};
+        expected.InsertEdge("hello", "how", 5);
+        expected.InsertEdge("how", "hello", 4);
+        REQUIRE(built == expected);
+      }
+    }
+  }
+  GIVEN("A DG whose nodes are looked up by id") {
+    gdwg::Graph<std::string, int> g{"hello", "how", "are"};
+    auto hello = g.GetId("hello");
+    auto how = g.GetId("how");
+    WHEN("Edges are inserted and queried by id") {
+      g.InsertEdge(hello, how, 5);
+      g.InsertEdge(hello, how, 3);
+      THEN("The graph matches the value-based API") {
+        REQUIRE(g.GetValue(hello) == "hello");
+        REQUIRE(g.IsConnected("hello", "how"));
+        REQUIRE(g.IsConnected(hello, how));
+        REQUIRE(!g.IsConnected(how, hello));
+        REQUIRE(g.GetWeights(hello, how) == std::vector<int>{3, 5});
+        REQUIRE(g.GetConnected(hello) == g.GetConnected("hello"));
+        REQUIRE(g.erase(hello, how, 5));
+        REQUIRE(!g.erase(hello, how, 5));
+      }
+    }
+    WHEN("A node is replaced or deleted") {
+      g.Replace("hello", "bye");
+      g.DeleteNode("how");
+      THEN("Its id follows the node and deleted ids are rejected") {
+        REQUIRE(g.GetId("bye") == hello);
+        REQUIRE(g.GetValue(hello) == "bye");
+        REQUIRE(!g.IsNode(how));
+        REQUIRE_THROWS_WITH(g.GetId("how"),
+                            "Cannot call Graph::GetId if val doesn't exist in the graph");
+        REQUIRE_THROWS_WITH(g.GetValue(how),
+                            "Cannot call Graph::GetValue if id doesn't exist in the graph");
+        REQUIRE_THROWS_WITH(
+            g.InsertEdge(hello, how, 1),
+            "Cannot call Graph::InsertEdge when either src or dst node does not exist");
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"are", "bye"});
+      }
+    }
+    WHEN("The nodes are integers themselves") {
+      gdwg::Graph<std::uint32_t, int> ints{7u, 3u};
+      ints.InsertEdge(7u, 3u, 1);
+      ints.InsertEdge(ints.GetId(3u), ints.GetId(7u), 2);
+      THEN("Values and ids are never confused") {
+        REQUIRE(ints.GetConnected(7u) == std::vector<std::uint32_t>{3u});
+        REQUIRE(ints.GetConnected(ints.GetId(3u)) == std::vector<std::uint32_t>{7u});
+        REQUIRE(ints.IdBound() == 2);
+      }
+    }
+  }
+  GIVEN("A hub node with more out-edges than the edge index threshold") {
+    gdwg::Graph<int, int> g;
+    const int n = static_cast<int>(gdwg::Graph<int, int>::Node::kEdgeIndexThreshold) * 2;
+    for (int i = 0; i <= n; ++i)
+      g.InsertNode(i);
+    for (int i = n; i > 0; --i) {
+      g.InsertEdge(0, i, i % 3);
+      g.InsertEdge(0, i, i % 3 + 1);
+    }
+    WHEN("Duplicate edges are inserted") {
+      bool res = g.InsertEdge(0, 5, 5 % 3);
+      THEN("They are rejected and the rest of the edges are kept in order") {
+        REQUIRE(res == false);
+        REQUIRE(g.GetConnected(0).size() == static_cast<std::size_t>(2 * n));
+        REQUIRE(g.GetWeights(0, 5) == std::vector<int>{2, 3});
+      }
+    }
+    WHEN("Edges are erased and nodes are deleted") {
+      g.erase(0, 7, 7 % 3);
+      g.DeleteNode(8);
+      THEN("Lookups through the index see the changes") {
+        REQUIRE(g.IsConnected(0, 7));
+        REQUIRE(!g.erase(0, 7, 7 % 3));
+        REQUIRE(g.erase(0, 7, 7 % 3 + 1));
+        REQUIRE(!g.IsConnected(0, 7));
+        g.InsertNode(8);
+        REQUIRE(!g.IsConnected(0, 8));
+        REQUIRE(g.InsertEdge(0, 8, 1));
+      }
+    }
+    WHEN("A destination is merge-replaced into another destination") {
+      g.MergeReplace(1, 2);
+      THEN("Edges that become duplicates are dropped") {
+        REQUIRE(g.GetWeights(0, 2) == std::vector<int>{1, 2, 3});
+        REQUIRE(!g.IsNode(1));
+      }
+    }
+  }
+  GIVEN("A linked hub node with more edges each way than the edge index threshold") {
+    gdwg::Graph<std::string, int> g;
+    const int n = static_cast<int>(gdwg::Graph<std::string, int>::Node::kEdgeIndexThreshold) * 2;
+    g.InsertNode("hub");
+    for (int i = 0; i < n; ++i) {
+      g.InsertNode(std::to_string(i));
+      g.InsertEdge("hub", std::to_string(i), i);
+      g.InsertEdge(std::to_string(i), "hub", i);
+    }
+    WHEN("Every other in-edge is erased") {
+      for (int i = 0; i < n; i += 2) {
+        REQUIRE(g.erase(std::to_string(i), "hub", i));
+      }
+      THEN("The rest follow the hub when it is merge-replaced") {
+        REQUIRE(!g.InsertEdge("hub", "5", 5));
+        g.InsertNode("other");
+        g.MergeReplace("hub", "other");
+        for (int i = 0; i < n; ++i) {
+          REQUIRE(g.IsConnected(std::to_string(i), "other") == (i % 2 == 1));
+        }
+        REQUIRE(g.GetConnected("other").size() == static_cast<std::size_t>(n));
+      }
+    }
+  }
 }
 
 // OPERATORS
@@ -491,6 +805,28 @@ SCENARIO("Testing iterator functions") {
         }
       }
     }
+    WHEN("Graph is looped over through a const reference") {
+      const auto& cg = g;
+      THEN("begin() and end() don't need a mutable graph and give the same order") {
+        auto it = cg.begin();
+        REQUIRE(*it == std::make_tuple("are", "you?", 3));
+        int i = 0;
+        for (; it != cg.end(); ++it)
+          ++i;
+        REQUIRE(i == 6);
+      }
+    }
+    WHEN("A node that other edges point to is replaced") {
+      g.Replace("are", "zebra");
+      THEN("Edges into it are reordered by the new destination value") {
+        auto it = g.find("hello", "how", 5);
+        ++it;
+        REQUIRE(*it == std::make_tuple("hello", "zebra", 2));
+        ++it;
+        REQUIRE(*it == std::make_tuple("hello", "zebra", 8));
+        REQUIRE(g.GetConnected("hello") == std::vector<std::string>{"how", "zebra", "zebra"});
+      }
+    }
     WHEN("edge iterator is incremented all the way to the end") {
       auto it=g.begin();
       auto tuple = *it;
@@ -604,5 +940,280 @@ SCENARIO("Testing iterator functions") {
         REQUIRE(it==g.end());
       }
     }
+    WHEN("Find is given an existing source and destination but the wrong weight") {
+      auto it = g.find("hello", "are", 5);
+      THEN("end() is returned") { REQUIRE(it == g.end()); }
+    }
+    WHEN("Every edge out of a hub node is found and erased in turn") {
+      for (int i = 0; i < 100; ++i) {
+        g.InsertEdge("how", "are", i);
+      }
+      for (int i = 0; i < 100; ++i) {
+        auto it = g.erase(g.find("how", "are", i));
+        REQUIRE(*it == (i < 99 ? std::make_tuple("how", "are", i + 1)
+                               : std::make_tuple("how", "hello", 4)));
+      }
+      THEN("The hub is back to its original edges") {
+        REQUIRE(g.GetConnected("how") == std::vector<std::string>{"hello", "you?"});
+        REQUIRE(!g.IsConnected("how", "are"));
+        REQUIRE(g.find("how", "are", 50) == g.end());
+      }
+    }
+    WHEN("A node's last edge is erased and the next node has no edges") {
+      g.erase("how", "hello", 4);
+      g.InsertNode("i");
+      g.InsertEdge("you?", "i", 6);
+      auto it = g.erase(g.find("how", "you?", 1));
+      THEN("The returned iterator skips to the next node with edges") {
+        REQUIRE(*it == std::make_tuple("you?", "i", 6));
+        REQUIRE(++it == g.end());
+      }
+    }
+  }
+}
+
+SCENARIO("Testing the instrumentation policy") {
+  GIVEN("A graph with CountingInstrumentation") {
+    gdwg::Graph<std::string, int, gdwg::CountingInstrumentation> g{"hello", "how", "are"};
+    g.InsertEdge("hello", "how", 5);
+    g.InsertEdge("hello", "are", 8);
+    g.InsertEdge("how", "are", 2);
+    const auto& stats = g.Stats();
+    THEN("Inserts are counted with the nodes and edges they allocated") {
+      REQUIRE(stats[gdwg::GraphOp::kInsertNode].calls == 3);
+      REQUIRE(stats[gdwg::GraphOp::kInsertNode].allocations == 3);
+      REQUIRE(stats[gdwg::GraphOp::kInsertEdge].calls == 3);
+      REQUIRE(stats[gdwg::GraphOp::kInsertEdge].allocations == 3);
+      REQUIRE(stats[gdwg::GraphOp::kInsertEdge].LatencyPercentile(1) > 0);
+    }
+    WHEN("An existing edge is inserted again") {
+      g.InsertEdge("hello", "how", 5);
+      THEN("It is a call that allocates nothing") {
+        REQUIRE(stats[gdwg::GraphOp::kInsertEdge].calls == 4);
+        REQUIRE(stats[gdwg::GraphOp::kInsertEdge].allocations == 3);
+      }
+    }
+    WHEN("The edges are iterated over and the last one is found") {
+      for (auto it = g.begin(); it != g.end(); ++it) {
+      }
+      auto it = g.find("how", "are", 2);
+      THEN("Increments are counted and find goes straight to the edge") {
+        REQUIRE(stats[gdwg::GraphOp::kIncrement].calls == 3);
+        REQUIRE(stats[gdwg::GraphOp::kFind].calls == 1);
+        REQUIRE(stats[gdwg::GraphOp::kFind].edgesScanned == 0);
+      }
+      AND_WHEN("It is erased through the iterator") {
+        g.erase(it);
+        THEN("It is taken out of its destination's in-edges without scanning them") {
+          REQUIRE(stats[gdwg::GraphOp::kErase].calls == 1);
+          REQUIRE(stats[gdwg::GraphOp::kErase].edgesScanned == 0);
+        }
+      }
+    }
+    WHEN("A node is deleted and the stats are exported") {
+      g.DeleteNode("how");
+      std::vector<std::string> names;
+      std::uint64_t scanned = 0;
+      g.Stats().ForEach([&](const char* name, const gdwg::OpStats& op) {
+        names.push_back(name);
+        if (names.back() == "DeleteNode")
+          scanned = op.edgesScanned;
+      });
+      THEN("Every operation is exported by name") {
+        REQUIRE(names.size() == static_cast<std::size_t>(gdwg::GraphOp::kCount));
+        REQUIRE(names.front() == "InsertNode");
+        REQUIRE(scanned > 0);
+      }
+    }
+  }
+  GIVEN("The default graph") {
+    THEN("Its policy takes up no space") {
+      REQUIRE(std::is_empty_v<gdwg::NoInstrumentation>);
+      REQUIRE(std::is_empty_v<gdwg::NoInstrumentation::Cursor>);
+      // Graph keeps the policy as a private base, where an empty one adds nothing
+      struct WithPolicy : private gdwg::NoInstrumentation {
+        std::map<int, int> members;
+      };
+      REQUIRE(sizeof(WithPolicy) == sizeof(std::map<int, int>));
+      // Iterators are no more than the three map iterators they held before
+      REQUIRE(sizeof(gdwg::Graph<int, int>::const_iterator) ==
+              3 * sizeof(std::map<int, int>::const_iterator));
+    }
+  }
+}
+
+SCENARIO("Testing IsReachable") {
+  GIVEN("A chain a -> b -> c -> d with a loop back from c to b") {
+    gdwg::Graph<char, int> g{'a', 'b', 'c', 'd', 'e'};
+    g.InsertEdge('a', 'b', 1);
+    g.InsertEdge('b', 'c', 1);
+    g.InsertEdge('c', 'd', 1);
+    g.InsertEdge('c', 'b', 1);
+    THEN("Paths are followed past direct edges") {
+      REQUIRE(g.IsReachable('a', 'd'));
+      REQUIRE(g.IsReachable('c', 'b'));
+      REQUIRE(!g.IsReachable('d', 'a'));
+      REQUIRE(!g.IsReachable('a', 'e'));
+      REQUIRE(g.IsReachable('e', 'e'));
+      REQUIRE(!g.IsConnected('a', 'd'));
+    }
+    WHEN("Edges are added after the first query") {
+      REQUIRE(!g.IsReachable('d', 'a'));
+      g.InsertEdge('d', 'e', 2);
+      g.InsertEdges({{'e', 'a', 3}, {'e', 'f', 3}});
+      THEN("The answers include them") {
+        REQUIRE(g.IsReachable('d', 'a'));
+        REQUIRE(g.IsReachable('b', 'f'));
+        REQUIRE(!g.IsReachable('f', 'a'));
+      }
+    }
+    WHEN("An edge that a path needs is erased") {
+      REQUIRE(g.IsReachable('a', 'd'));
+      g.erase('b', 'c', 1);
+      THEN("The path is gone") {
+        REQUIRE(!g.IsReachable('a', 'd'));
+        REQUIRE(g.IsReachable('c', 'b'));
+      }
+    }
+    WHEN("An edge with a way around it is erased") {
+      g.InsertEdge('a', 'c', 1);
+      REQUIRE(g.IsReachable('a', 'd'));
+      g.erase('a', 'b', 1);
+      THEN("Everything that was reachable still is") {
+        REQUIRE(g.IsReachable('a', 'b'));
+        REQUIRE(g.IsReachable('a', 'd'));
+      }
+    }
+    WHEN("A node on the path is deleted and its id reused") {
+      REQUIRE(g.IsReachable('a', 'd'));
+      g.DeleteNode('c');
+      g.InsertNode('z');
+      g.InsertEdge('z', 'd', 1);
+      THEN("Nothing goes through it anymore") {
+        REQUIRE(!g.IsReachable('a', 'd'));
+        REQUIRE(!g.IsReachable('a', 'z'));
+        REQUIRE(g.IsReachable('z', 'd'));
+      }
+    }
+    WHEN("The graph is copied after a query") {
+      REQUIRE(g.IsReachable('a', 'd'));
+      auto copy = g;
+      copy.erase('c', 'd', 1);
+      THEN("Each answers for itself") {
+        REQUIRE(!copy.IsReachable('a', 'd'));
+        REQUIRE(g.IsReachable('a', 'd'));
+      }
+    }
+    THEN("Nodes that don't exist throw") {
+      REQUIRE_THROWS_WITH(
+          g.IsReachable('a', 'q'),
+          "Cannot call Graph::IsReachable if src or dst node don't exist in the graph");
+    }
+  }
+  GIVEN("g -> a -> b -> c -> d, with b -> e -> c as a second way from b to c") {
+    gdwg::Graph<char, int> g{'a', 'b', 'c', 'd', 'e', 'g'};
+    g.InsertEdges({{'g', 'a', 1}, {'a', 'b', 1}, {'b', 'c', 1}, {'c', 'd', 1}, {'b', 'e', 1},
+                   {'e', 'c', 1}});
+    REQUIRE(g.IsReachable('g', 'd'));
+    WHEN("A node every path from g goes through is deleted") {
+      g.DeleteNode('a');
+      THEN("Only the paths through it are gone") {
+        REQUIRE(!g.IsReachable('g', 'b'));
+        REQUIRE(!g.IsReachable('g', 'd'));
+        REQUIRE(g.IsReachable('b', 'd'));
+      }
+      AND_WHEN("A node with a way around it is deleted after that") {
+        g.DeleteNode('e');
+        THEN("Everything else that was reachable still is") {
+          REQUIRE(g.IsReachable('b', 'c'));
+          REQUIRE(g.IsReachable('b', 'd'));
+          REQUIRE(!g.IsReachable('c', 'b'));
+          REQUIRE(!g.IsReachable('g', 'c'));
+        }
+        AND_WHEN("Edges are added after both") {
+          g.InsertEdge('d', 'b', 1);
+          g.InsertNode('e');
+          g.InsertEdge('g', 'e', 1);
+          THEN("The answers include them") {
+            REQUIRE(g.IsReachable('c', 'b'));
+            REQUIRE(g.IsReachable('d', 'c'));
+            REQUIRE(!g.IsReachable('g', 'b'));
+            REQUIRE(!g.IsReachable('e', 'g'));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Testing graphs of small trivially copyable types") {
+  GIVEN("A Graph<std::uint32_t, float> with keys near 0, a large key and a copy") {
+    gdwg::Graph<std::uint32_t, float> g;
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+      g.InsertNode(i);
+    }
+    g.InsertNode(4000000000u);
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+      g.InsertEdge(i, (i * 7) % 2000, 0.5f);
+      g.InsertEdge(i, 4000000000u, 1.5f);
+    }
+    auto copy = g;
+    THEN("Its out-edges are kept as flat arrays of destinations and weights") {
+      REQUIRE(gdwg::Graph<std::uint32_t, float>::kPacked);
+      REQUIRE(!gdwg::Graph<std::string, int>::kPacked);
+      REQUIRE(!gdwg::Graph<std::uint32_t, std::string>::kPacked);
+    }
+    WHEN("A node with a self edge and edges both ways is renamed") {
+      g.InsertEdge(5, 5, 2.5f);
+      g.InsertEdge(35, 5, 3.5f);
+      REQUIRE(g.Replace(5, 2500));
+      THEN("Every edge follows it and stays in order") {
+        REQUIRE(g.GetConnected(2500) == std::vector<std::uint32_t>{35, 2500, 4000000000u});
+        REQUIRE(g.GetConnected(35) == std::vector<std::uint32_t>{245, 2500, 4000000000u});
+        REQUIRE(g.GetWeights(2500, 2500) == std::vector<float>{2.5f});
+        REQUIRE(g.IsReachable(35, 2500));
+      }
+      THEN("Iterating backwards visits the same edges in reverse") {
+        std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> forward;
+        std::vector<std::tuple<std::uint32_t, std::uint32_t, float>> backward;
+        for (auto it = g.begin(); it != g.end(); ++it) {
+          forward.push_back(*it);
+        }
+        for (auto it = g.rbegin(); it != g.rend(); ++it) {
+          backward.push_back(*it);
+        }
+        std::reverse(backward.begin(), backward.end());
+        REQUIRE(forward.size() == 4002);
+        REQUIRE(std::is_sorted(forward.begin(), forward.end()));
+        REQUIRE(forward == backward);
+      }
+    }
+    THEN("Lookups work on either side of the flat table") {
+      REQUIRE(g.IsNode(1999));
+      REQUIRE(!g.IsNode(2000));
+      REQUIRE(g.IsConnected(3, 21));
+      REQUIRE(copy.IsConnected(3, 4000000000u));
+      REQUIRE(g.find(5, 35, 0.5f) != g.end());
+    }
+    WHEN("A node with in-edges is renamed to a key outside the table") {
+      REQUIRE(g.Replace(21, 3000000000u));
+      THEN("Its in-edges show the new value and stay in order") {
+        REQUIRE(g.GetConnected(3) == std::vector<std::uint32_t>{3000000000u, 4000000000u});
+        REQUIRE(g.GetWeights(3, 3000000000u) == std::vector<float>{0.5f});
+        REQUIRE(!g.IsNode(21));
+        REQUIRE(g.find(3, 3000000000u, 0.5f) != g.end());
+        REQUIRE(std::get<1>(*g.find(3, 3000000000u, 0.5f)) == 3000000000u);
+        REQUIRE(copy.IsConnected(3, 21));
+      }
+      AND_WHEN("It is renamed back and deleted") {
+        REQUIRE(g.Replace(3000000000u, 21));
+        REQUIRE(g.DeleteNode(21));
+        THEN("The key can be inserted again") {
+          REQUIRE(!g.IsNode(21));
+          REQUIRE(g.InsertNode(21));
+          REQUIRE(g.GetConnected(3) == std::vector<std::uint32_t>{4000000000u});
+        }
+      }
+    }
   }
 }
@@ -0,0 +1,156 @@
+#ifndef ASSIGNMENTS_DG_INSTRUMENTATION_H_
+#define ASSIGNMENTS_DG_INSTRUMENTATION_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace gdwg {
+
+// Graph operations an instrumentation policy hears about
+enum class GraphOp : std::size_t {
+  kInsertNode,
+  kInsertEdge,
+  kInsertEdges,
+  kDeleteNode,
+  kReplace,
+  kMergeReplace,
+  kErase,
+  kFind,
+  kIncrement,
+  kCount
+};
+
+inline const char* ToString(GraphOp op) {
+  static constexpr const char* kNames[] = {"InsertNode", "InsertEdge",   "InsertEdges",
+                                           "DeleteNode", "Replace",      "MergeReplace",
+                                           "erase",      "find",         "increment"};
+  return op < GraphOp::kCount ? kNames[static_cast<std::size_t>(op)] : "unknown";
+}
+
+// The third parameter of Graph, which is told about every instrumented call.
+// This default does nothing at all, so a Graph that doesn't opt in pays nothing for it.
+// A policy needs:
+// - Scope, constructed from (const policy&, GraphOp) for the length of each call
+// - Cursor, constructed from a const policy* and kept by iterators, with stepped()
+// - scanned(n) and allocated(n), for edges looked at and nodes or edges created
+// Every hook is const, since read-only calls are instrumented too
+struct NoInstrumentation {
+  struct Scope {
+    Scope(const NoInstrumentation&, GraphOp) {}
+  };
+  struct Cursor {
+    Cursor() = default;
+    explicit Cursor(const NoInstrumentation*) {}
+    void stepped() const {}
+  };
+  void scanned(std::size_t) const {}
+  void allocated(std::size_t) const {}
+};
+
+// What CountingInstrumentation has seen of one operation
+struct OpStats {
+  std::uint64_t calls = 0;
+  std::uint64_t edgesScanned = 0;
+  std::uint64_t allocations = 0;
+  // latency[i] counts calls that took [2^i, 2^(i+1)) nanoseconds
+  std::array<std::uint64_t, 64> latency{};
+
+  // Upper end of the latency bucket the p-th fraction of calls fall within, p in (0, 1]
+  std::uint64_t LatencyPercentile(double p) const {
+    std::uint64_t total = 0;
+    for (const auto& count : latency) {
+      total += count;
+    }
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < latency.size(); ++i) {
+      seen += latency[i];
+      if (seen > 0 && static_cast<double>(seen) >= p * static_cast<double>(total))
+        return i == 63 ? UINT64_MAX : (std::uint64_t{2} << i) - 1;
+    }
+    return 0;
+  }
+};
+
+// Counts calls, edges scanned and nodes or edges allocated, and keeps a latency histogram,
+// for each operation. Calls made from inside another instrumented call count towards the
+// outer one. Iterator steps taken inside an instrumented call count as edges scanned, the
+// caller's own are counted as increments.
+// Like Graph itself, it isn't safe to use from more than one thread at once
+class CountingInstrumentation {
+ public:
+  class Scope {
+   public:
+    Scope(const CountingInstrumentation& owner, GraphOp op) : owner_{owner} {
+      if (owner_.depth_++ == 0) {
+        owner_.active_ = op;
+        ++owner_.stats_[static_cast<std::size_t>(op)].calls;
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope() {
+      if (--owner_.depth_ == 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start_)
+                           .count();
+        auto ns = static_cast<std::uint64_t>(elapsed) | 1;
+        ++owner_.stats_[static_cast<std::size_t>(owner_.active_)]
+              .latency[63 - static_cast<std::size_t>(__builtin_clzll(ns))];
+      }
+    }
+
+   private:
+    const CountingInstrumentation& owner_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  class Cursor {
+   public:
+    Cursor() = default;
+    explicit Cursor(const CountingInstrumentation* owner) : owner_{owner} {}
+    void stepped() const {
+      if (owner_ == nullptr)
+        return;
+      if (owner_->depth_ > 0) {
+        owner_->scanned(1);
+      } else {
+        ++owner_->stats_[static_cast<std::size_t>(GraphOp::kIncrement)].calls;
+      }
+    }
+
+   private:
+    const CountingInstrumentation* owner_ = nullptr;
+  };
+
+  void scanned(std::size_t n) const {
+    if (depth_ > 0)
+      stats_[static_cast<std::size_t>(active_)].edgesScanned += n;
+  }
+  void allocated(std::size_t n) const {
+    if (depth_ > 0)
+      stats_[static_cast<std::size_t>(active_)].allocations += n;
+  }
+
+  const OpStats& operator[](GraphOp op) const { return stats_[static_cast<std::size_t>(op)]; }
+  // Calls f(const char* name, const OpStats&) for every operation, for exporting
+  template <typename F>
+  void ForEach(F f) const {
+    for (std::size_t op = 0; op < stats_.size(); ++op) {
+      f(ToString(static_cast<GraphOp>(op)), stats_[op]);
+    }
+  }
+  void Reset() { stats_ = {}; }
+
+ private:
+  mutable std::array<OpStats, static_cast<std::size_t>(GraphOp::kCount)> stats_{};
+  // How many instrumented calls are in progress, and the outermost one
+  mutable std::size_t depth_ = 0;
+  mutable GraphOp active_ = GraphOp::kCount;
+};
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_INSTRUMENTATION_H_
@@ -0,0 +1,128 @@
+#ifndef ASSIGNMENTS_DG_INTERN_TABLE_H_
+#define ASSIGNMENTS_DG_INTERN_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+namespace detail {
+
+// Whether std::hash is enabled for T
+template <typename T, typename = void>
+struct IsHashable : std::false_type {};
+template <typename T>
+struct IsHashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T&>()))>>
+  : std::true_type {};
+
+// Node value to id.
+// Integral values go straight into a flat array indexed by the value, since graphs keyed by
+// integers are nearly always keyed by 0..n-1 or close to it. The array is only grown while
+// it stays within a few slots per entry, so values too large or negative to fit go in a
+// hash table instead (or a std::map when N can't be hashed), which is all other types use.
+template <typename N>
+class InternTable {
+ public:
+  static constexpr std::uint32_t kMissing = UINT32_MAX;
+  // Whether values can go in the flat array at all
+  static constexpr bool kDense = std::is_integral_v<N> && !std::is_same_v<N, bool>;
+
+  // Id of val, or kMissing
+  std::uint32_t find(const N& val) const {
+    if constexpr (kDense) {
+      auto slot = denseSlot(val);
+      if (slot < dense.size())
+        return dense[slot];
+    }
+    auto it = fallback.find(val);
+    return it == fallback.end() ? kMissing : it->second;
+  }
+
+  // val mustn't be in the table already
+  void emplace(const N& val, std::uint32_t id) {
+    ++count;
+    if constexpr (kDense) {
+      auto slot = denseSlot(val);
+      if (slot >= dense.size() && fitsDense(slot))
+        grow(slot);
+      if (slot < dense.size()) {
+        dense[slot] = id;
+        return;
+      }
+    }
+    fallback.emplace(val, id);
+  }
+
+  void erase(const N& val) {
+    if constexpr (kDense) {
+      auto slot = denseSlot(val);
+      if (slot < dense.size()) {
+        count -= dense[slot] != kMissing;
+        dense[slot] = kMissing;
+        return;
+      }
+    }
+    count -= fallback.erase(val);
+  }
+
+  void clear() {
+    dense.clear();
+    fallback.clear();
+    count = 0;
+  }
+
+ private:
+  // Slots the array can always have, however few values there are
+  static constexpr std::size_t kMinDense = 1024;
+  static constexpr std::size_t kSlotsPerEntry = 4;
+  static constexpr std::size_t kNoSlot = SIZE_MAX;
+
+  // Empty unless N is integral
+  std::vector<std::uint32_t> dense;
+  std::conditional_t<IsHashable<N>::value,
+                     std::unordered_map<N, std::uint32_t>,
+                     std::map<N, std::uint32_t>>
+      fallback;
+  std::size_t count = 0;
+
+  static std::size_t denseSlot(const N& val) {
+    if constexpr (std::is_signed_v<N>) {
+      if (val < 0)
+        return kNoSlot;
+    }
+    return static_cast<std::size_t>(val);
+  }
+
+  bool fitsDense(std::size_t slot) const {
+    return slot < std::max(kMinDense, kSlotsPerEntry * count);
+  }
+
+  // Grows the array to take slot, then moves over anything in fallback it now covers
+  void grow(std::size_t slot) {
+    auto size = std::max(slot + 1, 2 * dense.size());
+    dense.resize(std::max(slot + 1, std::min(size, std::max(kMinDense, kSlotsPerEntry * count))),
+                 kMissing);
+    for (auto it = fallback.begin(); it != fallback.end();) {
+      auto moved = denseSlot(it->first);
+      if (moved < dense.size()) {
+        dense[moved] = it->second;
+        it = fallback.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+};
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_INTERN_TABLE_H_
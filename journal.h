@@ -0,0 +1,103 @@
+#ifndef ASSIGNMENTS_DG_JOURNAL_H_
+#define ASSIGNMENTS_DG_JOURNAL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+
+template <typename N, typename E, typename I>
+class Graph;
+
+// One entry in a MutationLog
+enum class Mutation : std::uint8_t {
+  kInsertNode,
+  kDeleteNode,
+  kInsertEdge,
+  kEraseEdge,
+  kReplace,
+  kCount,
+};
+
+namespace detail {
+
+// Whether values of T can be written to a MutationLog
+template <typename T>
+constexpr bool kLoggable = std::is_trivially_copyable_v<T> || std::is_same_v<T, std::string>;
+
+}  // namespace detail
+
+// Append-only record of the changes made to a Graph, for replaying them onto another graph or
+// undoing them.
+// A graph writes to a log between Record(&log) and Record(nullptr), and each entry gets the
+// next sequence number. DeleteNode, MergeReplace and Clear are written as the edge and node
+// removals they're made of, so every entry can be undone by itself and rolling back a batch
+// only costs as much as the batch did. Assigning to a graph replaces it wholesale and isn't
+// written, so a log can't be replayed or rolled back across one.
+// Entries are packed into one byte array, an op byte followed by its values. Trivially
+// copyable values are stored as their bytes and strings as a varint length and the characters,
+// so an encoded log can only be decoded where the byte order and type sizes are the same.
+template <typename N, typename E>
+class MutationLog {
+ public:
+  // Default constructor, an empty log starting at sequence number 0
+  MutationLog<N, E>() = default;
+
+  // Sequence number of the first entry kept, and the one the next entry will get
+  std::uint64_t Begin() const { return first; }
+  std::uint64_t End() const { return first + starts.size(); }
+  std::size_t Bytes() const { return bytes.size(); }
+
+  // Replays entries [from, to) onto target, with runs of edge inserts going in one InsertEdges
+  template <typename I>
+  void Apply(Graph<N, E, I>& target, std::uint64_t from, std::uint64_t to) const;
+  template <typename I>
+  void Apply(Graph<N, E, I>& target) const {
+    Apply(target, Begin(), End());
+  }
+
+  // Undoes every entry from to onwards on g, newest first, by appending their opposites.
+  // Sequence numbers that were handed out keep meaning the same change, so a replica that
+  // already applied them catches up by applying the opposites like any other entries.
+  // g has to be the graph that was recorded, with nothing changed since that wasn't recorded
+  template <typename I>
+  void Rollback(Graph<N, E, I>& g, std::uint64_t to);
+
+  // Drops the entries before upTo, once nothing needs to replay or undo them
+  void Discard(std::uint64_t upTo);
+
+  // Entries [from, to), for sending to another process and decoding there
+  std::vector<std::uint8_t> Encode(std::uint64_t from, std::uint64_t to) const;
+  static MutationLog<N, E> Decode(const std::vector<std::uint8_t>& encoded);
+
+ private:
+  template <typename, typename, typename>
+  friend class Graph;
+
+  std::uint64_t first = 0;
+  // Where each entry starts in bytes
+  std::vector<std::size_t> starts;
+  std::vector<std::uint8_t> bytes;
+
+  // Appends an entry, called by Graph as it changes
+  void node(Mutation op, const N& val);
+  void edge(Mutation op, const N& src, const N& dst, const E& w);
+  void replace(const N& oldData, const N& newData);
+
+  template <typename T>
+  void put(const T& val);
+  template <typename T>
+  T get(std::size_t& pos) const;
+  // Moves pos past one value, false if it would run off the end
+  template <typename T>
+  bool skip(std::size_t& pos) const;
+  void checkRange(std::uint64_t from, std::uint64_t to, const char* message) const;
+};
+
+}  // namespace gdwg
+#include "assignments/dg/journal.tpp"
+
+#endif  // ASSIGNMENTS_DG_JOURNAL_H_
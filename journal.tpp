@@ -0,0 +1,275 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/varint.h"
+
+template <typename N, typename E>
+void gdwg::MutationLog<N, E>::node(Mutation op, const N& val) {
+  starts.push_back(bytes.size());
+  bytes.push_back(static_cast<std::uint8_t>(op));
+  put(val);
+}
+
+template <typename N, typename E>
+void gdwg::MutationLog<N, E>::edge(Mutation op, const N& src, const N& dst, const E& w) {
+  starts.push_back(bytes.size());
+  bytes.push_back(static_cast<std::uint8_t>(op));
+  put(src);
+  put(dst);
+  put(w);
+}
+
+template <typename N, typename E>
+void gdwg::MutationLog<N, E>::replace(const N& oldData, const N& newData) {
+  starts.push_back(bytes.size());
+  bytes.push_back(static_cast<std::uint8_t>(Mutation::kReplace));
+  put(oldData);
+  put(newData);
+}
+
+// Graph can't start recording for types that aren't loggable, so those never get here
+template <typename N, typename E>
+template <typename T>
+void gdwg::MutationLog<N, E>::put(const T& val) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    detail::PutVarint(bytes, val.size());
+    bytes.insert(bytes.end(), val.begin(), val.end());
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    auto at = bytes.size();
+    bytes.resize(at + sizeof(T));
+    std::memcpy(bytes.data() + at, &val, sizeof(T));
+  } else {
+    (void)val;
+  }
+}
+
+template <typename N, typename E>
+template <typename T>
+T gdwg::MutationLog<N, E>::get(std::size_t& pos) const {
+  static_assert(detail::kLoggable<T>, "MutationLog can only store trivially copyable values or "
+                                      "std::string");
+  if constexpr (std::is_same_v<T, std::string>) {
+    auto size = static_cast<std::size_t>(detail::GetVarint(bytes.data(), pos));
+    std::string val(reinterpret_cast<const char*>(bytes.data() + pos), size);
+    pos += size;
+    return val;
+  } else {
+    T val;
+    std::memcpy(&val, bytes.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return val;
+  }
+}
+
+template <typename N, typename E>
+template <typename T>
+bool gdwg::MutationLog<N, E>::skip(std::size_t& pos) const {
+  if constexpr (std::is_same_v<T, std::string>) {
+    // The length's last byte has its top bit clear
+    std::size_t end = pos;
+    while (end < bytes.size() && end - pos < 10 && (bytes[end] & 0x80) != 0)
+      ++end;
+    if (end >= bytes.size() || end - pos == 10)
+      return false;
+    auto size = detail::GetVarint(bytes.data(), pos);
+    if (size > bytes.size() - pos)
+      return false;
+    pos += static_cast<std::size_t>(size);
+    return true;
+  } else {
+    if (sizeof(T) > bytes.size() - pos)
+      return false;
+    pos += sizeof(T);
+    return true;
+  }
+}
+
+template <typename N, typename E>
+void gdwg::MutationLog<N, E>::checkRange(std::uint64_t from,
+                                         std::uint64_t to,
+                                         const char* message) const {
+  if (from < Begin() || to > End() || from > to) {
+    throw std::out_of_range(message);
+  }
+}
+
+template <typename N, typename E>
+template <typename I>
+void gdwg::MutationLog<N, E>::Apply(Graph<N, E, I>& target,
+                                    std::uint64_t from,
+                                    std::uint64_t to) const {
+  checkRange(from, to, "Cannot call MutationLog::Apply if from and to aren't a range in the log");
+  std::vector<std::tuple<N, N, E>> batch;
+  const auto flush = [&batch, &target] {
+    target.InsertEdges(batch.begin(), batch.end());
+    batch.clear();
+  };
+  for (auto seq = from; seq < to; ++seq) {
+    auto pos = starts[seq - first];
+    auto op = static_cast<Mutation>(bytes[pos++]);
+    if (op != Mutation::kInsertEdge && !batch.empty())
+      flush();
+    switch (op) {
+      case Mutation::kInsertNode:
+        target.InsertNode(get<N>(pos));
+        break;
+      case Mutation::kDeleteNode:
+        target.DeleteNode(get<N>(pos));
+        break;
+      case Mutation::kInsertEdge: {
+        auto src = get<N>(pos);
+        auto dst = get<N>(pos);
+        batch.emplace_back(std::move(src), std::move(dst), get<E>(pos));
+        break;
+      }
+      case Mutation::kEraseEdge: {
+        auto src = get<N>(pos);
+        auto dst = get<N>(pos);
+        target.erase(src, dst, get<E>(pos));
+        break;
+      }
+      case Mutation::kReplace: {
+        auto oldData = get<N>(pos);
+        target.Replace(oldData, get<N>(pos));
+        break;
+      }
+      case Mutation::kCount:
+        break;
+    }
+  }
+  if (!batch.empty())
+    flush();
+}
+
+// Each entry is undone by its opposite, with runs of erased edges put back in one InsertEdges.
+// g records into this log while it does, so the opposites are appended as it goes and are
+// never themselves undone by this call
+template <typename N, typename E>
+template <typename I>
+void gdwg::MutationLog<N, E>::Rollback(Graph<N, E, I>& g, std::uint64_t to) {
+  checkRange(to, End(), "Cannot call MutationLog::Rollback if to isn't in the log");
+  auto recording = g.Recording();
+  g.Record(this);
+  std::vector<std::tuple<N, N, E>> batch;
+  const auto flush = [&batch, &g] {
+    g.InsertEdges(batch.begin(), batch.end());
+    batch.clear();
+  };
+  for (auto seq = End(); seq > to; --seq) {
+    auto pos = starts[seq - 1 - first];
+    auto op = static_cast<Mutation>(bytes[pos++]);
+    if (op != Mutation::kEraseEdge && !batch.empty())
+      flush();
+    switch (op) {
+      case Mutation::kInsertNode:
+        g.DeleteNode(get<N>(pos));
+        break;
+      case Mutation::kDeleteNode:
+        g.InsertNode(get<N>(pos));
+        break;
+      case Mutation::kInsertEdge: {
+        auto src = get<N>(pos);
+        auto dst = get<N>(pos);
+        g.erase(src, dst, get<E>(pos));
+        break;
+      }
+      case Mutation::kEraseEdge: {
+        auto src = get<N>(pos);
+        auto dst = get<N>(pos);
+        batch.emplace_back(std::move(src), std::move(dst), get<E>(pos));
+        break;
+      }
+      case Mutation::kReplace: {
+        auto oldData = get<N>(pos);
+        g.Replace(get<N>(pos), oldData);
+        break;
+      }
+      case Mutation::kCount:
+        break;
+    }
+  }
+  if (!batch.empty())
+    flush();
+  g.Record(recording);
+}
+
+template <typename N, typename E>
+void gdwg::MutationLog<N, E>::Discard(std::uint64_t upTo) {
+  checkRange(Begin(), upTo, "Cannot call MutationLog::Discard if upTo isn't in the log");
+  auto dropped = static_cast<std::size_t>(upTo - first);
+  auto cut = dropped < starts.size() ? starts[dropped] : bytes.size();
+  bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(cut));
+  starts.erase(starts.begin(), starts.begin() + static_cast<std::ptrdiff_t>(dropped));
+  for (auto& start : starts) {
+    start -= cut;
+  }
+  first = upTo;
+}
+
+// The sequence number of the first entry as a varint, then the entries as they're stored
+template <typename N, typename E>
+std::vector<std::uint8_t> gdwg::MutationLog<N, E>::Encode(std::uint64_t from,
+                                                          std::uint64_t to) const {
+  checkRange(from, to, "Cannot call MutationLog::Encode if from and to aren't a range in the log");
+  std::vector<std::uint8_t> encoded;
+  detail::PutVarint(encoded, from);
+  if (from == to)
+    return encoded;
+  auto begin = starts[from - first];
+  auto end = to - first < starts.size() ? starts[to - first] : bytes.size();
+  encoded.insert(encoded.end(), bytes.begin() + static_cast<std::ptrdiff_t>(begin),
+                 bytes.begin() + static_cast<std::ptrdiff_t>(end));
+  return encoded;
+}
+
+// Walks every entry to find where each starts, checking nothing runs off the end
+template <typename N, typename E>
+gdwg::MutationLog<N, E> gdwg::MutationLog<N, E>::Decode(const std::vector<std::uint8_t>& encoded) {
+  static_assert(detail::kLoggable<N> && detail::kLoggable<E>,
+                "MutationLog can only store trivially copyable values or std::string");
+  MutationLog<N, E> log;
+  log.bytes = encoded;
+  std::size_t pos = 0;
+  const auto malformed = [] {
+    return std::runtime_error("Cannot call MutationLog::Decode on a malformed log");
+  };
+  // The header is the same varint format skip checks for string lengths
+  std::size_t end = 0;
+  while (end < encoded.size() && end < 10 && (encoded[end] & 0x80) != 0)
+    ++end;
+  if (end >= encoded.size() || end == 10)
+    throw malformed();
+  log.first = detail::GetVarint(encoded.data(), pos);
+
+  while (pos < encoded.size()) {
+    log.starts.push_back(pos);
+    auto op = encoded[pos++];
+    bool ok = true;
+    switch (static_cast<Mutation>(op)) {
+      case Mutation::kInsertNode:
+      case Mutation::kDeleteNode:
+        ok = log.template skip<N>(pos);
+        break;
+      case Mutation::kInsertEdge:
+      case Mutation::kEraseEdge:
+        ok = log.template skip<N>(pos) && log.template skip<N>(pos) && log.template skip<E>(pos);
+        break;
+      case Mutation::kReplace:
+        ok = log.template skip<N>(pos) && log.template skip<N>(pos);
+        break;
+      default:
+        ok = false;
+    }
+    if (!ok)
+      throw malformed();
+  }
+  // Entries are kept without the header, so every start moves back by its size
+  log.bytes.erase(log.bytes.begin(), log.bytes.begin() + static_cast<std::ptrdiff_t>(end + 1));
+  for (auto& start : log.starts) {
+    start -= end + 1;
+  }
+  return log;
+}
@@ -0,0 +1,198 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  A graph is recorded while every kind of mutation is made to it, and the log
+  is replayed onto an empty graph, which then has to compare equal to it.
+  Sequence numbers are checked to count every entry, including the edge
+  removals DeleteNode and MergeReplace are written as. Replace is also called
+  with the node's own value, which it must write before renaming the node.
+
+  Rolling back is checked by copying the graph, making a batch of changes
+  that touches every kind of entry, rolling back to before them and comparing
+  against the copy. The graph has to still be recording afterwards, with one
+  opposite appended per entry undone, and a replica that applied the batch has
+  to get back to the copy by applying those opposites.
+
+  Assigning to a recorded graph mustn't write anything, neither the old
+  contents going nor the new ones arriving, and recording carries on after.
+
+  Replication is checked with a generated int graph changed in rounds: after
+  each round the new entries are encoded, decoded and applied to a replica,
+  which has to match. Discarding entries the replica already has must not
+  change anything that comes after them.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <string>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+SCENARIO("Testing recording and replaying a graph") {
+  GIVEN("A recorded graph with every kind of change made to it") {
+    gdwg::Graph<std::string, int> g;
+    gdwg::MutationLog<std::string, int> log;
+    g.Record(&log);
+    g.InsertNode("a");
+    g.InsertNode("b");
+    g.InsertNode("c");
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "c", 2);
+    g.InsertEdge("c", "c", 3);
+    g.InsertEdge("a", "b", 1);
+    std::vector<std::tuple<std::string, std::string, int>> edges{{"c", "a", 4}, {"d", "a", 5}};
+    g.InsertEdges(edges.begin(), edges.end());
+    g.erase("b", "c", 2);
+    g.Replace("a", "x");
+    g.MergeReplace("d", "c");
+    g.DeleteNode("b");
+    WHEN("The log is replayed onto an empty graph") {
+      gdwg::Graph<std::string, int> replica;
+      log.Apply(replica);
+      THEN("The two are equal") {
+        REQUIRE(replica == g);
+        REQUIRE(replica.GetWeights("c", "x") == std::vector<int>{4, 5});
+      }
+    }
+    THEN("Every entry got a sequence number, and duplicates weren't recorded") {
+      // 4 nodes, 5 edges, 1 erase, 1 replace, merging d (2 entries for its edge and 1 for d)
+      // and deleting b (1 entry for its edge and 1 for b)
+      REQUIRE(log.Begin() == 0);
+      REQUIRE(log.End() == 16);
+    }
+    WHEN("A node is replaced through a reference to its own value") {
+      gdwg::Graph<std::string, int> replica;
+      log.Apply(replica);
+      auto from = log.End();
+      g.Replace(g.GetValue(g.GetId("x")), "y");
+      log.Apply(replica, from, log.End());
+      THEN("The old value is what was written") {
+        REQUIRE(replica == g);
+        REQUIRE(replica.IsNode("y"));
+      }
+    }
+    WHEN("It stops recording") {
+      auto end = log.End();
+      g.Record(nullptr);
+      g.InsertNode("q");
+      THEN("Nothing else is written") {
+        REQUIRE(log.End() == end);
+        REQUIRE(g.Recording() == nullptr);
+      }
+    }
+    THEN("Ranges outside the log throw") {
+      gdwg::Graph<std::string, int> replica;
+      REQUIRE_THROWS_AS(log.Apply(replica, 0, 17), std::out_of_range);
+      REQUIRE_THROWS_AS(log.Rollback(g, 17), std::out_of_range);
+      REQUIRE_THROWS_AS(log.Encode(3, 2), std::out_of_range);
+    }
+  }
+}
+
+SCENARIO("Testing rolling back a batch of changes") {
+  GIVEN("A recorded graph and a copy of it") {
+    gdwg::Graph<char, double> g{'a', 'b', 'c', 'd'};
+    g.InsertEdge('a', 'b', 1);
+    g.InsertEdge('b', 'c', 2);
+    g.InsertEdge('c', 'a', 3);
+    g.InsertEdge('d', 'd', 4);
+    const auto before = g;
+    gdwg::MutationLog<char, double> log;
+    g.Record(&log);
+    WHEN("A batch of changes is made and rolled back") {
+      gdwg::Graph<char, double> replica{before};
+      auto mark = log.End();
+      g.InsertNode('e');
+      g.InsertEdge('e', 'a', 5);
+      g.Replace('b', 'z');
+      g.MergeReplace('z', 'd');
+      g.erase('c', 'a', 3);
+      g.DeleteNode('d');
+      g.InsertEdge('a', 'c', 6);
+      g.Clear();
+      g.InsertNode('q');
+      REQUIRE(g != before);
+      auto end = log.End();
+      log.Apply(replica, mark, end);
+      log.Rollback(g, mark);
+      THEN("The graph is back where it was and still recording") {
+        REQUIRE(g == before);
+        REQUIRE(log.End() == end + (end - mark));
+        REQUIRE(g.Recording() == &log);
+        g.InsertNode('f');
+        REQUIRE(log.End() == end + (end - mark) + 1);
+      }
+      THEN("A replica that applied the batch gets back by applying the rollback") {
+        log.Apply(replica, end, log.End());
+        REQUIRE(replica == before);
+      }
+    }
+  }
+}
+
+SCENARIO("Testing assigning to a recorded graph") {
+  GIVEN("A recorded graph with a few changes in its log") {
+    gdwg::Graph<std::string, int> g{"a", "b"};
+    gdwg::MutationLog<std::string, int> log;
+    g.Record(&log);
+    g.InsertEdge("a", "b", 1);
+    g.InsertNode("c");
+    auto end = log.End();
+    WHEN("Another graph is copied and then moved into it") {
+      gdwg::Graph<std::string, int> other{"x", "y"};
+      other.InsertEdge("x", "y", 2);
+      g = other;
+      g = gdwg::Graph<std::string, int>{"p"};
+      THEN("Nothing is written, and it's still recording") {
+        REQUIRE(log.End() == end);
+        REQUIRE(g.Recording() == &log);
+        g.InsertNode("q");
+        REQUIRE(log.End() == end + 1);
+      }
+    }
+  }
+}
+
+SCENARIO("Testing replicating a graph through encoded logs") {
+  GIVEN("A generated graph changed in rounds and a replica") {
+    gdwg::Graph<int, int> g;
+    gdwg::Graph<int, int> replica;
+    gdwg::MutationLog<int, int> log;
+    g.Record(&log);
+    std::uint64_t sent = 0;
+    for (int round = 0; round < 5; ++round) {
+      for (int i = 0; i < 200; ++i) {
+        g.InsertNode(round * 200 + i);
+      }
+      auto nodes = g.GetNodes();
+      for (std::size_t i = 0; i < 600; ++i) {
+        g.InsertEdge(nodes[(i * 37 + round) % nodes.size()], nodes[(i * 11) % nodes.size()],
+                     static_cast<int>(i % 7));
+      }
+      for (std::size_t i = 0; i < 20; ++i) {
+        g.DeleteNode(nodes[(i * 53 + round * 7) % nodes.size()]);
+      }
+      auto encoded = log.Encode(sent, log.End());
+      auto decoded = gdwg::MutationLog<int, int>::Decode(encoded);
+      REQUIRE(decoded.Begin() == sent);
+      decoded.Apply(replica);
+      sent = log.End();
+      // The replica has everything before sent, so the log doesn't need it anymore
+      log.Discard(sent);
+    }
+    THEN("The replica matches after every round") {
+      REQUIRE(replica == g);
+      REQUIRE(log.Begin() == sent);
+      REQUIRE(log.Bytes() == 0);
+    }
+    THEN("Truncated encodings don't decode") {
+      g.InsertEdge(1, 2, 99);
+      auto encoded = log.Encode(log.Begin(), log.End());
+      encoded.pop_back();
+      REQUIRE_THROWS_AS((gdwg::MutationLog<int, int>::Decode(encoded)), std::runtime_error);
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#ifndef ASSIGNMENTS_DG_MAPPED_GRAPH_H_
+#define ASSIGNMENTS_DG_MAPPED_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+
+namespace gdwg {
+
+namespace detail {
+
+// How one column of values is laid out in a graph file.
+// Trivially copyable values are stored as a plain array and read in place
+template <typename T>
+struct MappedColumn {
+  static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8,
+                "MappedGraph can only store trivially copyable values or std::string");
+  static constexpr std::uint32_t kKind = 1;
+  static constexpr std::uint32_t kSize = sizeof(T);
+  using View = const T&;
+
+  template <typename F>
+  static void write(std::ostream& os, std::size_t count, F get);
+  // Points the column at its section of the file, false if it doesn't fit
+  bool bind(const char* base, std::uint64_t at, std::uint64_t count, std::uint64_t fileSize);
+  // Whether every value can be read without leaving the file, always true for plain arrays
+  bool check(std::uint64_t) const { return true; }
+  View operator[](std::size_t i) const { return values[i]; }
+
+  const T* values = nullptr;
+};
+
+// Strings are an array of count + 1 offsets into the characters that follow it
+template <>
+struct MappedColumn<std::string> {
+  static constexpr std::uint32_t kKind = 2;
+  static constexpr std::uint32_t kSize = 1;
+  using View = std::string_view;
+
+  template <typename F>
+  static void write(std::ostream& os, std::size_t count, F get);
+  bool bind(const char* base, std::uint64_t at, std::uint64_t count, std::uint64_t fileSize);
+  bool check(std::uint64_t count) const;
+  View operator[](std::size_t i) const {
+    return View{chars + index[i], static_cast<std::size_t>(index[i + 1] - index[i])};
+  }
+
+  const std::uint64_t* index = nullptr;
+  const char* chars = nullptr;
+};
+
+}  // namespace detail
+
+// A frozen graph saved to disk and read back through mmap.
+// Load() maps the file and checks its header, after which every query reads the mapped
+// arrays in place.
+// Files aren't trusted by default. Load() also makes one pass over the offsets, destinations
+// and string indexes, so no query on a corrupt file can read outside the mapping. It doesn't
+// check that nodes or edges are sorted, a file that gets those wrong gives wrong answers but
+// stays in bounds. LoadUnchecked() skips the pass, opening a graph for no more than the cost
+// of paging in its header, and is only for files this process or one it trusts wrote.
+// Nodes and weights have to be trivially copyable or std::string, and a file can only be
+// read back on a machine with the same byte order and type sizes it was written on.
+template <typename N, typename E>
+class MappedGraph {
+ public:
+  using NodeView = typename detail::MappedColumn<N>::View;
+  using WeightView = typename detail::MappedColumn<E>::View;
+
+  // Bumped whenever the layout changes, files from other versions are rejected
+  static constexpr std::uint32_t kVersion = 1;
+
+  static void Save(const CsrGraph<N, E>& g, const std::string& path);
+  static MappedGraph<N, E> Load(const std::string& path);
+  static MappedGraph<N, E> LoadUnchecked(const std::string& path);
+
+  MappedGraph<N, E>(const MappedGraph&) = delete;
+  MappedGraph<N, E>(MappedGraph&& orig) noexcept;
+  ~MappedGraph<N, E>();
+  MappedGraph& operator=(const MappedGraph&) = delete;
+  MappedGraph& operator=(MappedGraph&& orig) noexcept;
+
+  bool IsNode(const N& val) const;
+  bool IsConnected(const N& src, const N& dst) const;
+
+  std::vector<N> GetNodes() const;
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+
+  // Same layout as CsrGraph, read straight out of the file
+  std::size_t NodeCount() const { return nodeCount; }
+  std::size_t EdgeCount() const { return edgeCount; }
+  // Returns NodeCount() if val isn't a node
+  std::size_t IndexOf(const N& val) const;
+  NodeView ValueAt(std::size_t index) const { return nodes[index]; }
+  WeightView WeightAt(std::size_t edge) const { return weights[edge]; }
+  // NodeCount() + 1 entries
+  const std::uint64_t* Offsets() const { return offsets; }
+  const std::uint32_t* Destinations() const { return destinations; }
+
+ private:
+  // Start of the file, always 8 byte aligned
+  struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t nodeKind;
+    std::uint32_t nodeSize;
+    std::uint32_t weightKind;
+    std::uint32_t weightSize;
+    std::uint32_t unused;
+    std::uint64_t nodeCount;
+    std::uint64_t edgeCount;
+    // Byte offsets of each section from the start of the file
+    std::uint64_t nodesAt;
+    std::uint64_t offsetsAt;
+    std::uint64_t destinationsAt;
+    std::uint64_t weightsAt;
+    std::uint64_t fileSize;
+  };
+  static constexpr char kMagic[8] = {'G', 'D', 'W', 'G', 'C', 'S', 'R', '\0'};
+
+  MappedGraph<N, E>() = default;
+
+  void* mapping = nullptr;
+  std::size_t length = 0;
+  std::size_t nodeCount = 0;
+  std::size_t edgeCount = 0;
+  detail::MappedColumn<N> nodes;
+  const std::uint64_t* offsets = nullptr;
+  const std::uint32_t* destinations = nullptr;
+  detail::MappedColumn<E> weights;
+
+  // Load and LoadUnchecked, check says whether to make the pass over the arrays
+  static MappedGraph<N, E> mapFile(const std::string& path, bool check);
+  // Range of src's edges going to dst
+  std::pair<std::size_t, std::size_t> edgeRange(std::size_t src, std::size_t dst) const;
+};
+
+}  // namespace gdwg
+#include "assignments/dg/mapped_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_MAPPED_GRAPH_H_
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg {
+
+namespace detail {
+
+// Pads the stream out to the next multiple of 8 bytes
+inline void alignTo8(std::ostream& os) {
+  static constexpr char zeros[8] = {};
+  auto at = static_cast<std::uint64_t>(os.tellp());
+  os.write(zeros, static_cast<std::streamsize>((8 - at % 8) % 8));
+}
+
+template <typename T>
+template <typename F>
+void MappedColumn<T>::write(std::ostream& os, std::size_t count, F get) {
+  for (std::size_t i = 0; i < count; ++i) {
+    const T& value = get(i);
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+template <typename T>
+bool MappedColumn<T>::bind(const char* base,
+                           std::uint64_t at,
+                           std::uint64_t count,
+                           std::uint64_t fileSize) {
+  if (at % alignof(T) != 0 || at > fileSize || (fileSize - at) / sizeof(T) < count)
+    return false;
+  values = reinterpret_cast<const T*>(base + at);
+  return true;
+}
+
+template <typename F>
+void MappedColumn<std::string>::write(std::ostream& os, std::size_t count, F get) {
+  std::uint64_t end = 0;
+  os.write(reinterpret_cast<const char*>(&end), sizeof(end));
+  for (std::size_t i = 0; i < count; ++i) {
+    end += get(i).size();
+    os.write(reinterpret_cast<const char*>(&end), sizeof(end));
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::string& value = get(i);
+    os.write(value.data(), static_cast<std::streamsize>(value.size()));
+  }
+}
+
+inline bool MappedColumn<std::string>::bind(const char* base,
+                                            std::uint64_t at,
+                                            std::uint64_t count,
+                                            std::uint64_t fileSize) {
+  if (at % 8 != 0 || at > fileSize || (fileSize - at) / 8 <= count)
+    return false;
+  index = reinterpret_cast<const std::uint64_t*>(base + at);
+  chars = base + at + (count + 1) * 8;
+  // Only the ends are checked here, check() goes through the rest
+  return index[0] == 0 && index[count] <= fileSize - at - (count + 1) * 8;
+}
+
+inline bool MappedColumn<std::string>::check(std::uint64_t count) const {
+  for (std::uint64_t i = 0; i < count; ++i) {
+    if (index[i] > index[i + 1])
+      return false;
+  }
+  return true;
+}
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+// Writes a snapshot out as a graph file, replacing anything already at path
+template <typename N, typename E>
+void gdwg::MappedGraph<N, E>::Save(const CsrGraph<N, E>& g, const std::string& path) {
+  std::ofstream os{path, std::ios::binary | std::ios::trunc};
+  if (!os) {
+    throw std::runtime_error("Cannot call MappedGraph::Save on a path that can't be written");
+  }
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.nodeKind = detail::MappedColumn<N>::kKind;
+  header.nodeSize = detail::MappedColumn<N>::kSize;
+  header.weightKind = detail::MappedColumn<E>::kKind;
+  header.weightSize = detail::MappedColumn<E>::kSize;
+  header.nodeCount = g.NodeCount();
+  header.edgeCount = g.EdgeCount();
+
+  // The header is written twice, once to hold its place and again once the offsets are known
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  header.nodesAt = static_cast<std::uint64_t>(os.tellp());
+  detail::MappedColumn<N>::write(
+      os, g.NodeCount(), [&g](std::size_t i) -> const N& { return g.ValueAt(i); });
+  detail::alignTo8(os);
+  header.offsetsAt = static_cast<std::uint64_t>(os.tellp());
+  for (const auto& offset : g.Offsets()) {
+    auto value = static_cast<std::uint64_t>(offset);
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  header.destinationsAt = static_cast<std::uint64_t>(os.tellp());
+  os.write(reinterpret_cast<const char*>(g.Destinations().data()),
+           static_cast<std::streamsize>(g.Destinations().size() * sizeof(std::uint32_t)));
+  detail::alignTo8(os);
+  header.weightsAt = static_cast<std::uint64_t>(os.tellp());
+  detail::MappedColumn<E>::write(
+      os, g.EdgeCount(), [&g](std::size_t i) -> const E& { return g.Weights()[i]; });
+  detail::alignTo8(os);
+  header.fileSize = static_cast<std::uint64_t>(os.tellp());
+
+  os.seekp(0);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!os.flush()) {
+    throw std::runtime_error("Cannot call MappedGraph::Save on a path that can't be written");
+  }
+}
+
+// Maps a graph file written by Save
+template <typename N, typename E>
+gdwg::MappedGraph<N, E> gdwg::MappedGraph<N, E>::Load(const std::string& path) {
+  return mapFile(path, true);
+}
+
+template <typename N, typename E>
+gdwg::MappedGraph<N, E> gdwg::MappedGraph<N, E>::LoadUnchecked(const std::string& path) {
+  return mapFile(path, false);
+}
+
+template <typename N, typename E>
+gdwg::MappedGraph<N, E> gdwg::MappedGraph<N, E>::mapFile(const std::string& path, bool check) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that can't be opened");
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that isn't a graph file");
+  }
+
+  MappedGraph<N, E> g;
+  g.length = static_cast<std::size_t>(info.st_size);
+  g.mapping = ::mmap(nullptr, g.length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file alive on its own
+  ::close(fd);
+  if (g.mapping == MAP_FAILED) {
+    g.mapping = nullptr;
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that can't be mapped");
+  }
+
+  const auto base = static_cast<const char*>(g.mapping);
+  FileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  const auto size = static_cast<std::uint64_t>(g.length);
+  const bool valid = std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                     header.version == kVersion && header.fileSize == size;
+  if (!valid || header.nodeKind != detail::MappedColumn<N>::kKind ||
+      header.nodeSize != detail::MappedColumn<N>::kSize ||
+      header.weightKind != detail::MappedColumn<E>::kKind ||
+      header.weightSize != detail::MappedColumn<E>::kSize) {
+    throw std::runtime_error(
+        "Cannot call MappedGraph::Load on a file that isn't a graph file of this version and type");
+  }
+
+  g.nodeCount = static_cast<std::size_t>(header.nodeCount);
+  g.edgeCount = static_cast<std::size_t>(header.edgeCount);
+  const bool offsetsFit = header.offsetsAt % 8 == 0 && header.offsetsAt <= size &&
+                          (size - header.offsetsAt) / 8 > header.nodeCount;
+  const bool destinationsFit = header.destinationsAt % 4 == 0 && header.destinationsAt <= size &&
+                               (size - header.destinationsAt) / 4 >= header.edgeCount;
+  if (!offsetsFit || !destinationsFit ||
+      !g.nodes.bind(base, header.nodesAt, header.nodeCount, size) ||
+      !g.weights.bind(base, header.weightsAt, header.edgeCount, size)) {
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that is truncated");
+  }
+  g.offsets = reinterpret_cast<const std::uint64_t*>(base + header.offsetsAt);
+  g.destinations = reinterpret_cast<const std::uint32_t*>(base + header.destinationsAt);
+  if (g.offsets[g.nodeCount] != header.edgeCount) {
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that is truncated");
+  }
+  if (!check)
+    return g;
+
+  // Offsets that only go up and end at edgeCount keep every row inside destinations
+  bool inBounds = g.offsets[0] == 0;
+  for (std::size_t u = 0; u < g.nodeCount && inBounds; ++u) {
+    inBounds = g.offsets[u] <= g.offsets[u + 1];
+  }
+  for (std::size_t e = 0; e < g.edgeCount && inBounds; ++e) {
+    inBounds = g.destinations[e] < header.nodeCount;
+  }
+  if (!inBounds || !g.nodes.check(header.nodeCount) || !g.weights.check(header.edgeCount)) {
+    throw std::runtime_error("Cannot call MappedGraph::Load on a file that is corrupt");
+  }
+  return g;
+}
+
+template <typename N, typename E>
+gdwg::MappedGraph<N, E>::MappedGraph(MappedGraph&& orig) noexcept {
+  *this = std::move(orig);
+}
+
+template <typename N, typename E>
+gdwg::MappedGraph<N, E>::~MappedGraph() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, length);
+  }
+}
+
+template <typename N, typename E>
+gdwg::MappedGraph<N, E>& gdwg::MappedGraph<N, E>::operator=(MappedGraph&& orig) noexcept {
+  if (this != &orig) {
+    if (mapping != nullptr) {
+      ::munmap(mapping, length);
+    }
+    mapping = std::exchange(orig.mapping, nullptr);
+    length = std::exchange(orig.length, 0);
+    nodeCount = std::exchange(orig.nodeCount, 0);
+    edgeCount = std::exchange(orig.edgeCount, 0);
+    nodes = std::exchange(orig.nodes, {});
+    offsets = std::exchange(orig.offsets, nullptr);
+    destinations = std::exchange(orig.destinations, nullptr);
+    weights = std::exchange(orig.weights, {});
+  }
+  return *this;
+}
+
+template <typename N, typename E>
+std::size_t gdwg::MappedGraph<N, E>::IndexOf(const N& val) const {
+  std::size_t lo = 0;
+  std::size_t hi = nodeCount;
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (nodes[mid] < val)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo == nodeCount || val < nodes[lo])
+    return nodeCount;
+  return lo;
+}
+
+template <typename N, typename E>
+std::pair<std::size_t, std::size_t> gdwg::MappedGraph<N, E>::edgeRange(std::size_t src,
+                                                                      std::size_t dst) const {
+  auto first = destinations + offsets[src];
+  auto last = destinations + offsets[src + 1];
+  auto [lo, hi] = std::equal_range(first, last, static_cast<std::uint32_t>(dst));
+  return {static_cast<std::size_t>(lo - destinations), static_cast<std::size_t>(hi - destinations)};
+}
+
+// Checks if node exists
+template <typename N, typename E>
+bool gdwg::MappedGraph<N, E>::IsNode(const N& val) const {
+  return IndexOf(val) != nodeCount;
+}
+
+// Checks if there is an edge from src to dst
+template <typename N, typename E>
+bool gdwg::MappedGraph<N, E>::IsConnected(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodeCount || d == nodeCount) {
+    throw std::runtime_error(
+        "Cannot call MappedGraph::IsConnected if src or dst node don't exist in the graph");
+  }
+  auto [lo, hi] = edgeRange(s, d);
+  return lo != hi;
+}
+
+// Creates a vector containing all nodes in the file
+template <typename N, typename E>
+std::vector<N> gdwg::MappedGraph<N, E>::GetNodes() const {
+  std::vector<N> ret;
+  ret.reserve(nodeCount);
+  for (std::size_t i = 0; i < nodeCount; ++i) {
+    ret.emplace_back(nodes[i]);
+  }
+  return ret;
+}
+
+// Creates a vector containing the destination of every edge out of src
+template <typename N, typename E>
+std::vector<N> gdwg::MappedGraph<N, E>::GetConnected(const N& src) const {
+  auto s = IndexOf(src);
+  if (s == nodeCount) {
+    throw std::out_of_range(
+        "Cannot call MappedGraph::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> ret;
+  ret.reserve(static_cast<std::size_t>(offsets[s + 1] - offsets[s]));
+  for (auto e = offsets[s]; e < offsets[s + 1]; ++e) {
+    ret.emplace_back(nodes[destinations[e]]);
+  }
+  return ret;
+}
+
+// Creates a vector containing all weights of edges from src to dst
+template <typename N, typename E>
+std::vector<E> gdwg::MappedGraph<N, E>::GetWeights(const N& src, const N& dst) const {
+  auto s = IndexOf(src);
+  auto d = IndexOf(dst);
+  if (s == nodeCount || d == nodeCount) {
+    throw std::out_of_range(
+        "Cannot call MappedGraph::GetWeights if src or dst node don't exist in the graph");
+  }
+  auto [lo, hi] = edgeRange(s, d);
+  std::vector<E> ret;
+  ret.reserve(hi - lo);
+  for (auto e = lo; e < hi; ++e) {
+    ret.emplace_back(weights[e]);
+  }
+  return ret;
+}
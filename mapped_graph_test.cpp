@@ -0,0 +1,143 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Each scenario freezes a small graph, saves it and loads it back, then checks
+  that the loaded file answers the read API the same way the snapshot does.
+  Both a string node/int weight graph and an int node/string weight graph are
+  used, so each kind of column is read as both nodes and weights.
+
+  Files that are missing, truncated or saved with different types must be
+  refused with a runtime_error rather than read. So must files whose header is
+  right but whose offsets, destinations or string indexes would send a query
+  outside the file, which are made by overwriting single values in a saved
+  file. LoadUnchecked trusts the file and opens those anyway.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "assignments/dg/mapped_graph.h"
+#include "catch.h"
+
+SCENARIO("Testing MappedGraph round trips") {
+  GIVEN("A graph with string nodes saved to a file") {
+    const std::string path = "mapped_graph_test_strings.bin";
+    gdwg::Graph<std::string, int> g{"hello", "how", "are", "you?", "lonely"};
+    g.InsertEdge("hello", "how", 5);
+    g.InsertEdge("hello", "are", 8);
+    g.InsertEdge("hello", "are", 2);
+    g.InsertEdge("how", "you?", 1);
+    g.InsertEdge("how", "hello", 4);
+    g.InsertEdge("are", "you?", 3);
+    auto csr = g.Freeze();
+    gdwg::MappedGraph<std::string, int>::Save(csr, path);
+
+    WHEN("It is loaded back") {
+      auto mapped = gdwg::MappedGraph<std::string, int>::Load(path);
+      THEN("Every query gives the same answer as the snapshot") {
+        REQUIRE(mapped.NodeCount() == 5);
+        REQUIRE(mapped.EdgeCount() == 6);
+        REQUIRE(mapped.GetNodes() == csr.GetNodes());
+        REQUIRE(mapped.ValueAt(mapped.IndexOf("how")) == "how");
+        REQUIRE(mapped.GetConnected("hello") == csr.GetConnected("hello"));
+        REQUIRE(mapped.GetConnected("lonely").empty());
+        REQUIRE(mapped.GetWeights("hello", "are") == std::vector<int>{2, 8});
+        REQUIRE(mapped.IsConnected("how", "hello"));
+        REQUIRE(!mapped.IsConnected("hello", "you?"));
+        REQUIRE(!mapped.IsNode("bye"));
+        REQUIRE_THROWS_AS(mapped.GetConnected("bye"), std::out_of_range);
+        REQUIRE_THROWS_AS(mapped.IsConnected("hello", "bye"), std::runtime_error);
+      }
+      THEN("It can be moved and still be read") {
+        auto moved = std::move(mapped);
+        REQUIRE(moved.GetNodes() == csr.GetNodes());
+      }
+    }
+    WHEN("It is loaded with the wrong types") {
+      THEN("It is refused") {
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<int, int>::Load(path)), std::runtime_error);
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<std::string, double>::Load(path)),
+                          std::runtime_error);
+      }
+    }
+    WHEN("The file is cut short") {
+      std::string contents;
+      {
+        std::ifstream in{path, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+      }
+      {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size() - 8));
+      }
+      THEN("It is refused") {
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<std::string, int>::Load(path)), std::runtime_error);
+      }
+    }
+    WHEN("Its arrays are corrupted but the header still matches") {
+      std::string contents;
+      {
+        std::ifstream in{path, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+      }
+      // Overwrites the T at byte at + i * sizeof(T), where at is read from the header
+      const auto corrupt = [&contents, &path](std::size_t headerField, std::size_t i, auto value) {
+        std::uint64_t at;
+        std::memcpy(&at, contents.data() + headerField, sizeof(at));
+        auto copy = contents;
+        std::memcpy(copy.data() + at + i * sizeof(value), &value, sizeof(value));
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(copy.data(), static_cast<std::streamsize>(copy.size()));
+      };
+      // Where the header keeps nodesAt, offsetsAt and destinationsAt
+      const std::size_t nodesAt = 48;
+      const std::size_t offsetsAt = 56;
+      const std::size_t destinationsAt = 64;
+      THEN("A destination past the last node is refused, unless the file is trusted") {
+        corrupt(destinationsAt, 0, std::uint32_t{5});
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<std::string, int>::Load(path)), std::runtime_error);
+        auto trusted = gdwg::MappedGraph<std::string, int>::LoadUnchecked(path);
+        REQUIRE(trusted.Destinations()[0] == 5);
+      }
+      THEN("Offsets that go back down are refused") {
+        corrupt(offsetsAt, 1, std::uint64_t{6});
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<std::string, int>::Load(path)), std::runtime_error);
+      }
+      THEN("A string index out of order is refused") {
+        corrupt(nodesAt, 2, std::uint64_t{0});
+        REQUIRE_THROWS_AS((gdwg::MappedGraph<std::string, int>::Load(path)), std::runtime_error);
+      }
+    }
+    std::remove(path.c_str());
+  }
+  GIVEN("A graph with string weights saved to a file") {
+    const std::string path = "mapped_graph_test_weights.bin";
+    gdwg::Graph<int, std::string> g{1, 2, 3};
+    g.InsertEdge(1, 2, "b");
+    g.InsertEdge(1, 2, "a");
+    g.InsertEdge(3, 3, "");
+    gdwg::MappedGraph<int, std::string>::Save(g.Freeze(), path);
+
+    WHEN("It is loaded back") {
+      auto mapped = gdwg::MappedGraph<int, std::string>::Load(path);
+      THEN("Weights are read back in order, including empty ones") {
+        REQUIRE(mapped.GetWeights(1, 2) == std::vector<std::string>{"a", "b"});
+        REQUIRE(mapped.GetWeights(3, 3) == std::vector<std::string>{""});
+        REQUIRE(mapped.WeightAt(0) == "a");
+      }
+    }
+    std::remove(path.c_str());
+  }
+  GIVEN("A path that doesn't exist") {
+    THEN("Loading it throws") {
+      REQUIRE_THROWS_AS((gdwg::MappedGraph<int, int>::Load("no/such/graph.bin")),
+                        std::runtime_error);
+    }
+  }
+}
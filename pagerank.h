@@ -0,0 +1,81 @@
+#ifndef ASSIGNMENTS_DG_PAGERANK_H_
+#define ASSIGNMENTS_DG_PAGERANK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+#include "assignments/dg/parallel.h"
+
+namespace gdwg {
+
+// Weighted PageRank over a frozen graph, by power iteration.
+// A node passes its score on along its out-edges in proportion to their weights, and nodes
+// with no out-edges (or only zero weights) share theirs with every node.
+// Each iteration is a sparse matrix-vector product over the in-edges, so every node sums
+// its own row and no two threads write to the same score. Rows are split between threads
+// by edge count rather than node count, and each row is summed with AVX2 gathers when the
+// CPU has them.
+// Weights have to be arithmetic and can't be negative.
+// The snapshot has to outlive this object.
+template <typename N, typename E>
+class PageRank {
+  static_assert(std::is_arithmetic_v<E>, "PageRank needs arithmetic weights");
+
+ public:
+  // threads = 0 uses one per core
+  explicit PageRank<N, E>(const CsrGraph<N, E>& g, unsigned threads = 0);
+
+  // Iterates until the scores change by less than tolerance in total, or maxIterations
+  // is reached, and returns the number of iterations run
+  std::size_t Run(double damping = 0.85, double tolerance = 1e-9, std::size_t maxIterations = 100);
+
+  // Results of the last Run. Scores add up to 1 and are in GetNodes() order
+  const std::vector<double>& Scores() const;
+  double ScoreOf(const N& val) const;
+
+ private:
+  // Parts the rows are split into per thread, so a slow part doesn't hold the rest up
+  static constexpr std::size_t kPartsPerThread = 4;
+  static constexpr std::size_t kChunk = 1024;
+
+  const CsrGraph<N, E>& graph;
+  // In-edges, each row holds the sources of a node's in-edges and their weights
+  CsrGraph<N, E> reverse;
+  // reverse's weights as doubles, left empty when E is double and they can be used as is
+  std::vector<double> converted;
+  // Sum of each node's out-edge weights
+  std::vector<double> outWeight;
+  // Row boundaries of each part, with about the same number of edges in each
+  std::vector<std::size_t> parts;
+  unsigned threads;
+  // Kept for every Run, behind a pointer so a PageRank can still be moved
+  std::unique_ptr<detail::WorkerPool> pool;
+  // Sums weights[i] * scores[sources[i]] over a row
+  double (*rowSum)(const double* weights,
+                   const std::uint32_t* sources,
+                   const double* scores,
+                   std::size_t count);
+
+  std::vector<double> scores;
+  // scores[u] / outWeight[u], what each unit of edge weight out of u carries
+  std::vector<double> shares;
+  std::vector<double> next;
+  bool ran = false;
+
+  const double* weights() const {
+    if constexpr (std::is_same_v<E, double>) {
+      return reverse.Weights().data();
+    } else {
+      return converted.data();
+    }
+  }
+};
+
+}  // namespace gdwg
+#include "assignments/dg/pagerank.tpp"
+
+#endif  // ASSIGNMENTS_DG_PAGERANK_H_
@@ -0,0 +1,146 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Scores are first checked on graphs small enough to work out by hand: two
+  nodes pointing at each other split the score evenly, and a node with no
+  out-edges hands its score to everyone instead of losing it.
+
+  Weighted scores are compared against a plain dense power iteration written
+  out in the test, on a graph where the weights change the order of the nodes.
+
+  A larger generated graph, with a few hubs so the rows are uneven, is then
+  ranked with one thread and with several, and with int and double weights.
+  All four have to agree, since the row sums only differ in rounding.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "assignments/dg/pagerank.h"
+#include "catch.h"
+
+namespace {
+
+// Dense power iteration, the same model PageRank uses
+std::vector<double> referenceRank(const gdwg::CsrGraph<char, double>& g, double damping) {
+  const auto n = g.NodeCount();
+  std::vector<double> scores(n, 1.0 / n);
+  for (int iteration = 0; iteration < 200; ++iteration) {
+    std::vector<double> next(n, (1 - damping) / n);
+    for (std::size_t u = 0; u < n; ++u) {
+      double out = 0;
+      for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+        out += g.Weights()[e];
+      }
+      for (std::size_t v = 0; v < n; ++v) {
+        if (out == 0)
+          next[v] += damping * scores[u] / n;
+      }
+      for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1] && out > 0; ++e) {
+        next[g.Destinations()[e]] += damping * scores[u] * g.Weights()[e] / out;
+      }
+    }
+    scores = next;
+  }
+  return scores;
+}
+
+}  // namespace
+
+SCENARIO("Testing PageRank on small graphs") {
+  GIVEN("Two nodes pointing at each other") {
+    gdwg::Graph<std::string, int> g{"a", "b"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "a", 1);
+    auto csr = g.Freeze();
+    gdwg::PageRank<std::string, int> rank{csr, 1};
+    WHEN("It is ranked") {
+      auto iterations = rank.Run();
+      THEN("The score is split evenly straight away") {
+        REQUIRE(iterations == 1);
+        REQUIRE(rank.ScoreOf("a") == Approx(0.5));
+        REQUIRE(rank.ScoreOf("b") == Approx(0.5));
+      }
+    }
+    THEN("Asking for scores before Run or for a missing node throws") {
+      REQUIRE_THROWS_AS(rank.Scores(), std::runtime_error);
+      rank.Run();
+      REQUIRE_THROWS_AS(rank.ScoreOf("z"), std::out_of_range);
+    }
+  }
+  GIVEN("A weighted graph with a node that has no out-edges") {
+    gdwg::Graph<char, double> g{'a', 'b', 'c', 'd'};
+    g.InsertEdge('a', 'b', 1);
+    g.InsertEdge('a', 'c', 9);
+    g.InsertEdge('b', 'a', 2);
+    g.InsertEdge('c', 'a', 1);
+    g.InsertEdge('c', 'd', 1);
+    auto csr = g.Freeze();
+    gdwg::PageRank<char, double> rank{csr, 1};
+    WHEN("It is ranked to a tight tolerance") {
+      rank.Run(0.85, 1e-14, 1000);
+      auto expected = referenceRank(csr, 0.85);
+      THEN("It matches a dense power iteration and nothing is lost") {
+        const auto& scores = rank.Scores();
+        REQUIRE(std::accumulate(scores.begin(), scores.end(), 0.0) == Approx(1));
+        for (std::size_t i = 0; i < scores.size(); ++i) {
+          REQUIRE(scores[i] == Approx(expected[i]).epsilon(1e-9));
+        }
+        REQUIRE(rank.ScoreOf('c') > rank.ScoreOf('b'));
+      }
+    }
+  }
+  GIVEN("A graph with a negative weight") {
+    gdwg::Graph<char, int> g{'a', 'b'};
+    g.InsertEdge('a', 'b', -1);
+    auto csr = g.Freeze();
+    THEN("It can't be ranked") {
+      REQUIRE_THROWS_AS((gdwg::PageRank<char, int>{csr}), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Testing PageRank on a larger graph") {
+  GIVEN("A generated graph with a few hubs, weighted by int and by double") {
+    gdwg::Graph<int, int> ints;
+    gdwg::Graph<int, double> doubles;
+    const int n = 5000;
+    for (int i = 0; i < n; ++i) {
+      ints.InsertNode(i);
+      doubles.InsertNode(i);
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int k = 1; k <= 3; ++k) {
+        int dst = (i * 7 + k * 131) % n;
+        ints.InsertEdge(i, dst, k);
+        doubles.InsertEdge(i, dst, k);
+      }
+      // Every node also points at one of a few hubs, which gives those long rows
+      ints.InsertEdge(i, i % 5, 2);
+      doubles.InsertEdge(i, i % 5, 2);
+    }
+    auto intCsr = ints.Freeze();
+    auto doubleCsr = doubles.Freeze();
+    WHEN("It is ranked on one thread and on four") {
+      gdwg::PageRank<int, int> serial{intCsr, 1};
+      gdwg::PageRank<int, int> parallel{intCsr, 4};
+      gdwg::PageRank<int, double> asDouble{doubleCsr, 4};
+      auto iterations = serial.Run();
+      parallel.Run();
+      asDouble.Run();
+      THEN("All of them agree and stop before the limit") {
+        REQUIRE(iterations < 100);
+        for (int i = 0; i < n; ++i) {
+          REQUIRE(parallel.Scores()[i] == Approx(serial.Scores()[i]).epsilon(1e-12));
+          REQUIRE(asDouble.Scores()[i] == Approx(serial.Scores()[i]).epsilon(1e-12));
+        }
+        REQUIRE(serial.ScoreOf(0) > serial.ScoreOf(100));
+      }
+    }
+  }
+}
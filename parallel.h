@@ -0,0 +1,142 @@
+#ifndef ASSIGNMENTS_DG_PARALLEL_H_
+#define ASSIGNMENTS_DG_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gdwg {
+
+namespace detail {
+
+// Size that keeps per thread values from sharing a cache line
+constexpr std::size_t kCacheLine = 64;
+
+// A value on a cache line of its own, for totals each thread adds to in a loop
+template <typename T>
+struct alignas(kCacheLine) Padded {
+  T value{};
+};
+
+// Threads started once and kept waiting between loops, so algorithms that run a loop per
+// level or iteration don't start and join threads for each.
+// The thread calling For works as thread 0, so a pool of n threads keeps n - 1 waiting.
+// Calls to For from several threads at once take turns.
+class WorkerPool {
+ public:
+  explicit WorkerPool(unsigned threads) {
+    for (unsigned t = 1; t < threads; ++t) {
+      workers.emplace_back([this, t] { run(t); });
+    }
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  unsigned Size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+  // Calls fn(first, last, thread) over chunks of [0, count).
+  // Threads take chunks as they go, so a few expensive items don't hold one thread up, and
+  // work too small to fill two chunks runs on the calling thread
+  template <typename F>
+  void For(std::size_t count, std::size_t chunk, F fn) {
+    auto used = std::min<std::size_t>(Size(), (count + chunk - 1) / chunk);
+    if (used <= 1) {
+      fn(std::size_t{0}, count, 0u);
+      return;
+    }
+    std::lock_guard<std::mutex> turn{turnMutex};
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      job.call = [](void* f, std::size_t first, std::size_t last, unsigned t) {
+        (*static_cast<F*>(f))(first, last, t);
+      };
+      job.fn = &fn;
+      job.count = count;
+      job.chunk = chunk;
+      job.used = static_cast<unsigned>(used);
+      next.store(0, std::memory_order_relaxed);
+      running = job.used - 1;
+      ++generation;
+    }
+    wake.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock{mutex};
+    done.wait(lock, [this] { return running == 0; });
+  }
+
+ private:
+  // The loop being run, only changed while no worker is running it
+  struct Job {
+    void (*call)(void* fn, std::size_t first, std::size_t last, unsigned thread) = nullptr;
+    void* fn = nullptr;
+    std::size_t count = 0;
+    std::size_t chunk = 0;
+    unsigned used = 0;
+  };
+
+  std::vector<std::thread> workers;
+  // Held by the caller for the whole of a For
+  std::mutex turnMutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  Job job;
+  std::atomic<std::size_t> next{0};
+  // Bumped for every loop, so a worker can tell a new one from the one it last ran
+  std::uint64_t generation = 0;
+  // Workers still in the current loop
+  unsigned running = 0;
+  bool stopping = false;
+
+  void work(unsigned t) {
+    for (;;) {
+      auto first = next.fetch_add(job.chunk, std::memory_order_relaxed);
+      if (first >= job.count)
+        return;
+      job.call(job.fn, first, std::min(first + job.chunk, job.count), t);
+    }
+  }
+
+  // Waits for each loop and takes part if it uses this many threads
+  void run(unsigned t) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping)
+          return;
+        seen = generation;
+        if (t >= job.used)
+          continue;
+      }
+      work(t);
+      std::lock_guard<std::mutex> lock{mutex};
+      if (--running == 0)
+        done.notify_one();
+    }
+  }
+};
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_PARALLEL_H_
@@ -0,0 +1,90 @@
+#ifndef ASSIGNMENTS_DG_POOL_H_
+#define ASSIGNMENTS_DG_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+namespace detail {
+
+// Hands out T objects from fixed size slabs, so each graph node and edge doesn't need its
+// own heap block and control block. Destroyed slots are reused by later creates.
+// release() frees every slab at once without running destructors, so the owner has to
+// destroy anything that needs it first.
+template <typename T>
+class Pool {
+ public:
+  Pool() = default;
+  Pool(const Pool&) = delete;
+  Pool(Pool&& orig) noexcept
+    : slabs{std::move(orig.slabs)}, freeList{std::exchange(orig.freeList, nullptr)},
+      used{std::exchange(orig.used, kSlabSize)} {
+    orig.slabs.clear();
+  }
+  ~Pool() = default;
+
+  Pool& operator=(const Pool&) = delete;
+  Pool& operator=(Pool&& orig) noexcept {
+    slabs = std::move(orig.slabs);
+    orig.slabs.clear();
+    freeList = std::exchange(orig.freeList, nullptr);
+    used = std::exchange(orig.used, kSlabSize);
+    return *this;
+  }
+
+  template <typename... Args>
+  T* create(Args&&... args) {
+    Slot* slot;
+    if (freeList != nullptr) {
+      slot = freeList;
+      freeList = freeList->next;
+    } else {
+      if (used == kSlabSize) {
+        // Default initialised, so a new slab isn't zeroed
+        slabs.emplace_back(new Slot[kSlabSize]);
+        used = 0;
+      }
+      slot = &slabs.back()[used++];
+    }
+    return new (slot->storage) T(std::forward<Args>(args)...);
+  }
+
+  void destroy(T* object) {
+    object->~T();
+    auto slot = reinterpret_cast<Slot*>(object);
+    slot->next = freeList;
+    freeList = slot;
+  }
+
+  // Drops every slab, in O(number of slabs)
+  void release() {
+    slabs.clear();
+    freeList = nullptr;
+    used = kSlabSize;
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+  // Roughly 64KiB per slab, but never fewer than 16 objects
+  static constexpr std::size_t kSlabSize =
+      sizeof(Slot) * 16 > 65536 ? 16 : 65536 / sizeof(Slot);
+
+  std::vector<std::unique_ptr<Slot[]>> slabs;
+  // Destroyed slots waiting to be reused
+  Slot* freeList = nullptr;
+  // Slots handed out from the newest slab
+  std::size_t used = kSlabSize;
+};
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_POOL_H_
@@ -0,0 +1,267 @@
+#ifndef ASSIGNMENTS_DG_REACHABILITY_H_
+#define ASSIGNMENTS_DG_REACHABILITY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+namespace detail {
+
+// 2-hop reachability labels over a graph's node ids (pruned landmark labelling).
+// Every node is given a rank, and every node v keeps
+// - in[v], the ranks of hubs that reach v
+// - out[v], the ranks of hubs v reaches
+// such that src reaches dst exactly when out[src] and in[dst] share a hub. Both lists are
+// sorted, so a query is one merge over two short lists.
+//
+// Inserted edges are added by resuming the pruned searches of the hubs they affect.
+// An erased edge that leaves its endpoints unconnected might cut paths. Those wait until
+// the next query, which checks if the source can still reach the destination another way,
+// and only rebuilds if a check fails. A deleted node is checked the same way, one pair of
+// neighbours at a time, and its rank stays on in other labels standing in for those pairs.
+// Anything else, like inserting an edge that adds reachability while an erase is still
+// waiting, drops the labels until the next query.
+//
+// Ids come from the graph's nodes' getId(), neighbours from its destNode and sourceNode.
+template <typename Graph>
+class ReachabilityIndex {
+ public:
+  using Node = typename Graph::Node;
+
+  explicit ReachabilityIndex(const Graph& g) : graph{g}, nodes{g.nodesById} {}
+
+  bool Reaches(std::uint32_t src, std::uint32_t dst) {
+    validate();
+    return covered(src, dst);
+  }
+
+  // Graph calls these after making the change
+  void NodeAdded(std::uint32_t id) {
+    if (stale)
+      return;
+    if (id >= in.size()) {
+      in.resize(id + 1);
+      out.resize(id + 1);
+      rankOf.resize(id + 1);
+    }
+    auto rank = static_cast<std::uint32_t>(hubs.size());
+    hubs.push_back(id);
+    rankOf[id] = rank;
+    in[id] = {rank};
+    out[id] = {rank};
+  }
+  // The node had no edges left to or from other nodes, and NodeUnlinked was told which ones
+  // it had. Anything that reached it still reaches everything it reached once those checks
+  // pass, so its rank can stay in other nodes' labels. Its id may be reused, so erases
+  // waiting on it can't be checked anymore
+  void NodeRemoved(std::uint32_t id) {
+    if (stale)
+      return;
+    for (const auto& [src, dst] : pending) {
+      if (src == id || dst == id) {
+        Invalidate();
+        return;
+      }
+    }
+    hubs[rankOf[id]] = kRemoved;
+    in[id].clear();
+    out[id].clear();
+  }
+  void EdgeInserted(std::uint32_t src, std::uint32_t dst) {
+    if (stale || covered(src, dst))
+      return;
+    // Pruning trusts the labels, which erases waiting to be checked might have made wrong
+    if (!pending.empty()) {
+      Invalidate();
+      return;
+    }
+    // Hubs that reach src now reach everything dst does, and the other way around.
+    // Copies, since the searches can add to these lists
+    auto into = in[src];
+    auto outOf = out[dst];
+    for (auto rank : into) {
+      search(rank, dst, true, true);
+    }
+    for (auto rank : outOf) {
+      search(rank, src, false, true);
+    }
+  }
+  // Only for the last edge between src and dst, parallel edges keep the nodes connected
+  void EdgeErased(std::uint32_t src, std::uint32_t dst) {
+    if (stale)
+      return;
+    if (pending.size() == kMaxPending) {
+      stale = true;
+      return;
+    }
+    pending.emplace_back(src, dst);
+  }
+  // A node's edges to and from other nodes are gone, from are the nodes that had an edge to
+  // it and to the nodes it had an edge to. Every path through it went from one to the other
+  void NodeUnlinked(const std::vector<Node*>& from, const std::vector<Node*>& to) {
+    if (stale)
+      return;
+    if (from.size() * to.size() > kMaxPending - pending.size()) {
+      Invalidate();
+      return;
+    }
+    for (const auto& src : from) {
+      for (const auto& dst : to) {
+        if (src != dst)
+          EdgeErased(src->getId(), dst->getId());
+      }
+    }
+  }
+  // For changes that aren't worth tracking, the next query rebuilds
+  void Invalidate() {
+    stale = true;
+    pending.clear();
+  }
+
+ private:
+  // Past this many unchecked erases, rebuilding is likely cheaper than checking them
+  static constexpr std::size_t kMaxPending = 16;
+  static constexpr std::uint32_t kRemoved = UINT32_MAX;
+
+  const Graph& graph;
+  const std::vector<Node*>& nodes;
+  std::vector<std::vector<std::uint32_t>> in;
+  std::vector<std::vector<std::uint32_t>> out;
+  // Node id of each rank, kRemoved once that node is deleted, and the other way around
+  std::vector<std::uint32_t> hubs;
+  std::vector<std::uint32_t> rankOf;
+  bool stale = true;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> pending;
+
+  // Scratch for searches, stamp[v] == generation means v has been seen
+  std::vector<std::uint32_t> stamp;
+  std::uint32_t generation = 0;
+  std::vector<std::uint32_t> queue;
+
+  bool covered(std::uint32_t src, std::uint32_t dst) const {
+    const auto& a = out[src];
+    const auto& b = in[dst];
+    for (std::size_t i = 0, j = 0; i < a.size() && j < b.size();) {
+      if (a[i] == b[j])
+        return true;
+      a[i] < b[j] ? ++i : ++j;
+    }
+    return false;
+  }
+
+  void nextGeneration() {
+    if (generation == UINT32_MAX) {
+      stamp.assign(stamp.size(), 0);
+      generation = 0;
+    }
+    // Stamps start at 0, which is never a current generation
+    stamp.resize(nodes.size());
+    ++generation;
+  }
+
+  // Breadth first from start, adding the hub to the labels of every node it reaches that
+  // isn't already covered. forward follows out-edges and fills in-labels, otherwise it
+  // follows in-edges and fills out-labels. While building, hubs come in rank order, so
+  // labels can be appended to and stay sorted.
+  // A deleted hub has no labels of its own to prune with, but anything it already labels
+  // was reachable from it before, so everything past that already is too
+  void search(std::uint32_t rank, std::uint32_t start, bool forward, bool insertSorted) {
+    auto hub = hubs[rank];
+    nextGeneration();
+    queue.clear();
+    queue.push_back(start);
+    stamp[start] = generation;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      auto v = queue[head];
+      auto& label = forward ? in[v] : out[v];
+      if (hub == kRemoved ? std::binary_search(label.begin(), label.end(), rank)
+                          : forward ? covered(hub, v) : covered(v, hub))
+        continue;
+      if (insertSorted) {
+        label.insert(std::lower_bound(label.begin(), label.end(), rank), rank);
+      } else {
+        label.push_back(rank);
+      }
+      const auto node = nodes[v];
+      auto degree = forward ? node->degree() : node->inDegree();
+      for (std::size_t i = 0; i < degree; ++i) {
+        auto w = (forward ? graph.destNode(node, i) : graph.sourceNode(node, i))->getId();
+        if (stamp[w] != generation) {
+          stamp[w] = generation;
+          queue.push_back(w);
+        }
+      }
+    }
+  }
+
+  // Whether src still reaches dst, by a plain search since the labels might be out of date
+  bool searchPath(std::uint32_t src, std::uint32_t dst) {
+    nextGeneration();
+    queue.clear();
+    queue.push_back(src);
+    stamp[src] = generation;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      const auto node = nodes[queue[head]];
+      for (std::size_t i = 0; i < node->degree(); ++i) {
+        auto w = graph.destNode(node, i)->getId();
+        if (w == dst)
+          return true;
+        if (stamp[w] != generation) {
+          stamp[w] = generation;
+          queue.push_back(w);
+        }
+      }
+    }
+    return false;
+  }
+
+  void validate() {
+    if (!stale) {
+      // If every erased edge's source still reaches its destination, any path through one of
+      // them can go around it, so nothing became unreachable
+      for (const auto& [src, dst] : pending) {
+        if (!searchPath(src, dst)) {
+          stale = true;
+          break;
+        }
+      }
+      pending.clear();
+    }
+    if (stale)
+      rebuild();
+  }
+
+  void rebuild() {
+    in.assign(nodes.size(), {});
+    out.assign(nodes.size(), {});
+    rankOf.assign(nodes.size(), 0);
+    hubs.clear();
+    // Well connected nodes first, they cover the most pairs and prune later searches
+    for (std::uint32_t id = 0; id < nodes.size(); ++id) {
+      if (nodes[id] != nullptr)
+        hubs.push_back(id);
+    }
+    const auto score = [this](std::uint32_t id) {
+      return (nodes[id]->inDegree() + 1) * (nodes[id]->degree() + 1);
+    };
+    std::stable_sort(hubs.begin(), hubs.end(),
+                     [&score](std::uint32_t a, std::uint32_t b) { return score(a) > score(b); });
+    for (std::uint32_t rank = 0; rank < hubs.size(); ++rank) {
+      rankOf[hubs[rank]] = rank;
+      search(rank, hubs[rank], true, false);
+      search(rank, hubs[rank], false, false);
+    }
+    stale = false;
+    pending.clear();
+  }
+};
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_REACHABILITY_H_
@@ -0,0 +1,78 @@
+#ifndef ASSIGNMENTS_DG_SCC_H_
+#define ASSIGNMENTS_DG_SCC_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+#include "assignments/dg/parallel.h"
+
+namespace gdwg {
+
+// Strongly connected components of a frozen graph, found once on construction.
+// With one thread this is Tarjan's algorithm, run with an explicit stack so deep graphs
+// can't overflow the call stack. With more it first takes the component of the best
+// connected node with a forward and a backward search, then splits the rest by colour
+// propagation: every node takes the largest index that reaches it, and each colour's root
+// collects its component with a backward search that stays inside that colour. Before the
+// first search and every round of colouring, nodes left with no in-edges or no out-edges
+// among the rest are peeled off as components of their own, over and over, since a chain
+// would otherwise only lose one node per round.
+// Either way, component ids are numbered in order of each component's smallest node index,
+// so both give the same ids. Only node indices are stored, no node values are copied.
+// The snapshot has to outlive this object.
+template <typename N, typename E>
+class Scc {
+ public:
+  using ComponentId = std::uint32_t;
+
+  // threads = 0 uses one per core
+  explicit Scc<N, E>(const CsrGraph<N, E>& g, unsigned threads = 0);
+
+  std::size_t ComponentCount() const { return count; }
+  ComponentId ComponentOf(const N& val) const;
+  // Component of every node, indexed the same way as CsrGraph::ValueAt
+  const std::vector<ComponentId>& Components() const { return components; }
+
+  // Graph with a node per component and an edge between components for every edge between
+  // their nodes, with the same weight. Edges inside a component are left out, so the result
+  // has no cycles
+  Graph<ComponentId, E> Condensation() const;
+
+ private:
+  static constexpr ComponentId kNone = UINT32_MAX;
+  // Items each thread grabs at a time, and the least work worth waking threads for
+  static constexpr std::size_t kChunk = 1024;
+
+  using Bitmap = std::vector<std::atomic<std::uint64_t>>;
+
+  const CsrGraph<N, E>& graph;
+  // Until renumber, any id that is unique to the component
+  std::vector<ComponentId> components;
+  std::size_t count = 0;
+
+  void tarjan();
+  void coloring(detail::WorkerPool& pool);
+  // Makes each node in active that isn't on a cycle through the others a component, and
+  // takes it out. inLeft and outLeft are scratch, trimmed marks every node ever taken out
+  void trim(std::vector<std::uint32_t>& active,
+            const CsrGraph<N, E>& reverse,
+            std::vector<std::atomic<std::uint32_t>>& inLeft,
+            std::vector<std::atomic<std::uint32_t>>& outLeft,
+            Bitmap& trimmed,
+            detail::WorkerPool& pool);
+  // Marks every node without a component that start reaches through others without one
+  void reach(std::uint32_t start,
+             const CsrGraph<N, E>& edges,
+             Bitmap& seen,
+             detail::WorkerPool& pool) const;
+  // Numbers components by their smallest node, and sets count
+  void renumber();
+};
+
+}  // namespace gdwg
+#include "assignments/dg/scc.tpp"
+
+#endif  // ASSIGNMENTS_DG_SCC_H_
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::Scc<N, E>::Scc(const CsrGraph<N, E>& g, unsigned threads)
+  : graph{g}, components(g.NodeCount(), kNone) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (threads == 1) {
+    tarjan();
+  } else {
+    // Every loop of the search runs on the same threads, which go once it's done
+    detail::WorkerPool pool{threads};
+    coloring(pool);
+  }
+  renumber();
+}
+
+template <typename N, typename E>
+typename gdwg::Scc<N, E>::ComponentId gdwg::Scc<N, E>::ComponentOf(const N& val) const {
+  auto i = graph.IndexOf(val);
+  if (i == graph.NodeCount()) {
+    throw std::out_of_range("Cannot call Scc::ComponentOf if val doesn't exist in the graph");
+  }
+  return components[i];
+}
+
+template <typename N, typename E>
+gdwg::Graph<typename gdwg::Scc<N, E>::ComponentId, E> gdwg::Scc<N, E>::Condensation() const {
+  Graph<ComponentId, E> condensed;
+  for (ComponentId id = 0; id < count; ++id) {
+    condensed.InsertNode(id);
+  }
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  const auto& weights = graph.Weights();
+  std::vector<std::tuple<ComponentId, ComponentId, E>> edges;
+  for (std::size_t u = 0; u < graph.NodeCount(); ++u) {
+    for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+      if (components[u] != components[destinations[e]])
+        edges.emplace_back(components[u], components[destinations[e]], weights[e]);
+    }
+  }
+  condensed.InsertEdges(edges);
+  return condensed;
+}
+
+// Tarjan's algorithm, with the recursion kept in call as (node, next edge) pairs.
+// A node is on Tarjan's stack exactly when it has an index but no component yet
+template <typename N, typename E>
+void gdwg::Scc<N, E>::tarjan() {
+  const auto n = graph.NodeCount();
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  std::vector<std::uint32_t> index(n, kNone);
+  std::vector<std::uint32_t> low(n);
+  std::vector<std::uint32_t> stack;
+  std::vector<std::pair<std::uint32_t, std::size_t>> call;
+  std::uint32_t next = 0;
+
+  const auto visit = [&](std::uint32_t v) {
+    index[v] = low[v] = next++;
+    stack.push_back(v);
+    call.emplace_back(v, offsets[v]);
+  };
+  for (std::uint32_t root = 0; root < n; ++root) {
+    if (index[root] != kNone)
+      continue;
+    visit(root);
+    while (!call.empty()) {
+      auto v = call.back().first;
+      auto e = call.back().second;
+      if (e < offsets[v + 1]) {
+        ++call.back().second;
+        auto w = destinations[e];
+        if (index[w] == kNone) {
+          visit(w);
+        } else if (components[w] == kNone) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+      // Every edge of v is done, so return from it
+      call.pop_back();
+      if (!call.empty()) {
+        auto& parent = low[call.back().first];
+        parent = std::min(parent, low[v]);
+      }
+      if (low[v] == index[v]) {
+        std::uint32_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          components[w] = static_cast<ComponentId>(count);
+        } while (w != v);
+        ++count;
+      }
+    }
+  }
+}
+
+template <typename N, typename E>
+void gdwg::Scc<N, E>::coloring(detail::WorkerPool& pool) {
+  const auto n = graph.NodeCount();
+  const auto words = (n + 63) / 64;
+  const auto reverse = graph.Transpose();
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  const auto& inOffsets = reverse.Offsets();
+  const auto& inSources = reverse.Destinations();
+  const auto test = [](const Bitmap& bits, std::uint32_t v) {
+    return (bits[v / 64].load(std::memory_order_relaxed) >> (v % 64)) & 1;
+  };
+
+  std::vector<std::uint32_t> active(n);
+  for (std::uint32_t v = 0; v < n; ++v) {
+    active[v] = v;
+  }
+  std::vector<std::atomic<std::uint32_t>> inLeft(n);
+  std::vector<std::atomic<std::uint32_t>> outLeft(n);
+  Bitmap trimmed(words);
+  trim(active, reverse, inLeft, outLeft, trimmed, pool);
+  const auto dropAssigned = [this, &active] {
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [this](std::uint32_t v) { return components[v] != kNone; }),
+                 active.end());
+  };
+  if (active.empty())
+    return;
+
+  // Real graphs tend to have one giant component, and its best connected node is likely in
+  // it. Whatever both reaches and is reached by that node is its component
+  auto pivot = *std::max_element(active.begin(), active.end(), [&](auto a, auto b) {
+    return (offsets[a + 1] - offsets[a]) * (inOffsets[a + 1] - inOffsets[a]) <
+           (offsets[b + 1] - offsets[b]) * (inOffsets[b + 1] - inOffsets[b]);
+  });
+  Bitmap forward(words);
+  Bitmap backward(words);
+  reach(pivot, graph, forward, pool);
+  reach(pivot, reverse, backward, pool);
+  for (const auto& v : active) {
+    if (test(forward, v) && test(backward, v))
+      components[v] = pivot;
+  }
+  dropAssigned();
+
+  std::vector<std::atomic<std::uint32_t>> colors(n);
+  std::vector<std::uint32_t> roots;
+  std::vector<std::vector<std::uint32_t>> queues(pool.Size());
+  for (;;) {
+    // Removing components can leave more nodes that aren't on a cycle
+    trim(active, reverse, inLeft, outLeft, trimmed, pool);
+    if (active.empty())
+      break;
+    pool.For(active.size(), kChunk, [&](auto first, auto last, unsigned) {
+      for (auto i = first; i < last; ++i) {
+        colors[active[i]].store(active[i], std::memory_order_relaxed);
+      }
+    });
+    // Push the largest colour along out-edges until nothing changes
+    std::atomic<bool> changed{true};
+    while (changed.load(std::memory_order_relaxed)) {
+      changed.store(false, std::memory_order_relaxed);
+      pool.For(active.size(), kChunk, [&](auto first, auto last, unsigned) {
+        for (auto i = first; i < last; ++i) {
+          auto v = active[i];
+          auto colour = colors[v].load(std::memory_order_relaxed);
+          for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+            auto w = destinations[e];
+            if (components[w] != kNone)
+              continue;
+            auto old = colors[w].load(std::memory_order_relaxed);
+            while (old < colour &&
+                   !colors[w].compare_exchange_weak(old, colour, std::memory_order_relaxed)) {
+            }
+            if (old < colour)
+              changed.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+
+    // Each colour is everything its root reaches, so the root's component is the part of it
+    // that reaches back. Colours don't overlap, so each root's search only touches its own
+    roots.clear();
+    for (const auto& v : active) {
+      if (colors[v].load(std::memory_order_relaxed) == v)
+        roots.push_back(v);
+    }
+    pool.For(roots.size(), kChunk, [&](auto first, auto last, unsigned t) {
+      auto& queue = queues[t];
+      for (auto i = first; i < last; ++i) {
+        auto root = roots[i];
+        components[root] = root;
+        queue.assign(1, root);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+          auto v = queue[head];
+          for (auto e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+            auto w = inSources[e];
+            if (colors[w].load(std::memory_order_relaxed) == root && components[w] == kNone) {
+              components[w] = root;
+              queue.push_back(w);
+            }
+          }
+        }
+      }
+    });
+    dropAssigned();
+  }
+}
+
+// Counts each node's edges to and from the others, then peels off nodes whose count drops to
+// 0 level by level. Only the thread that marks a node trimmed takes it
+template <typename N, typename E>
+void gdwg::Scc<N, E>::trim(std::vector<std::uint32_t>& active,
+                           const CsrGraph<N, E>& reverse,
+                           std::vector<std::atomic<std::uint32_t>>& inLeft,
+                           std::vector<std::atomic<std::uint32_t>>& outLeft,
+                           Bitmap& trimmed,
+                           detail::WorkerPool& pool) {
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  const auto& inOffsets = reverse.Offsets();
+  const auto& inSources = reverse.Destinations();
+  const auto take = [&trimmed](std::uint32_t v) {
+    auto bit = std::uint64_t{1} << (v % 64);
+    return (trimmed[v / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+  };
+  // Edges to nodes that already have a component don't count
+  const auto left = [this](auto first, auto last, const auto& ends) {
+    std::uint32_t count = 0;
+    for (auto e = first; e < last; ++e) {
+      count += components[ends[e]] == kNone;
+    }
+    return count;
+  };
+
+  std::vector<std::vector<std::uint32_t>> next(pool.Size());
+  pool.For(active.size(), kChunk, [&](auto first, auto last, unsigned t) {
+    for (auto i = first; i < last; ++i) {
+      auto v = active[i];
+      auto out = left(offsets[v], offsets[v + 1], destinations);
+      auto in = left(inOffsets[v], inOffsets[v + 1], inSources);
+      outLeft[v].store(out, std::memory_order_relaxed);
+      inLeft[v].store(in, std::memory_order_relaxed);
+      if ((out == 0 || in == 0) && take(v))
+        next[t].push_back(v);
+    }
+  });
+  std::vector<std::uint32_t> frontier;
+  std::vector<std::uint32_t> peeled;
+  for (;;) {
+    frontier.clear();
+    for (auto& part : next) {
+      frontier.insert(frontier.end(), part.begin(), part.end());
+      part.clear();
+    }
+    if (frontier.empty())
+      break;
+    peeled.insert(peeled.end(), frontier.begin(), frontier.end());
+    // Taking v out removes an in-edge from everything it points to, and the other way around
+    pool.For(frontier.size(), kChunk, [&](auto first, auto last, unsigned t) {
+      for (auto i = first; i < last; ++i) {
+        auto v = frontier[i];
+        for (auto e = offsets[v]; e < offsets[v + 1]; ++e) {
+          auto w = destinations[e];
+          if (components[w] == kNone &&
+              inLeft[w].fetch_sub(1, std::memory_order_relaxed) == 1 && take(w))
+            next[t].push_back(w);
+        }
+        for (auto e = inOffsets[v]; e < inOffsets[v + 1]; ++e) {
+          auto w = inSources[e];
+          if (components[w] == kNone &&
+              outLeft[w].fetch_sub(1, std::memory_order_relaxed) == 1 && take(w))
+            next[t].push_back(w);
+        }
+      }
+    });
+  }
+
+  // Components are only written once every count is done with them
+  for (const auto& v : peeled) {
+    components[v] = v;
+  }
+  active.erase(std::remove_if(active.begin(), active.end(),
+                              [this](std::uint32_t v) { return components[v] != kNone; }),
+               active.end());
+}
+
+// Level by level from start, each level split over threads
+template <typename N, typename E>
+void gdwg::Scc<N, E>::reach(std::uint32_t start,
+                            const CsrGraph<N, E>& edges,
+                            Bitmap& seen,
+                            detail::WorkerPool& pool) const {
+  const auto& offsets = edges.Offsets();
+  const auto& destinations = edges.Destinations();
+  std::vector<std::uint32_t> frontier{start};
+  std::vector<std::vector<std::uint32_t>> next(pool.Size());
+  seen[start / 64].fetch_or(std::uint64_t{1} << (start % 64), std::memory_order_relaxed);
+  while (!frontier.empty()) {
+    pool.For(frontier.size(), kChunk, [&](auto first, auto last, unsigned t) {
+      for (auto i = first; i < last; ++i) {
+        auto u = frontier[i];
+        for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+          auto v = destinations[e];
+          auto bit = std::uint64_t{1} << (v % 64);
+          // Only the thread that sets the bit takes v
+          if (components[v] != kNone ||
+              (seen[v / 64].fetch_or(bit, std::memory_order_relaxed) & bit) != 0)
+            continue;
+          next[t].push_back(v);
+        }
+      }
+    });
+    frontier.clear();
+    for (auto& part : next) {
+      frontier.insert(frontier.end(), part.begin(), part.end());
+      part.clear();
+    }
+  }
+}
+
+template <typename N, typename E>
+void gdwg::Scc<N, E>::renumber() {
+  std::vector<ComponentId> ids(components.size(), kNone);
+  count = 0;
+  for (auto& component : components) {
+    auto& id = ids[component];
+    if (id == kNone)
+      id = static_cast<ComponentId>(count++);
+    component = id;
+  }
+}
@@ -0,0 +1,131 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Components and the condensation are first checked on a small graph that can
+  be worked out by hand: two cycles joined one way, a self loop, and a node
+  with no edges at all.
+
+  A larger generated graph, with many small cycles and a few chains between
+  them, is then split with one thread (Tarjan) and with several (colouring).
+  Component ids are numbered the same way by both, so the results are compared
+  directly. Splitting the condensation again has to leave every node in a
+  component of its own, which checks there are no cycles left.
+
+  A long chain that closes into one big cycle checks that Tarjan's algorithm
+  doesn't recurse, since a recursive version would overflow the stack on it.
+  A long chain running from the largest index down to a small cycle is split
+  with several threads too. Colouring alone only takes one node of it off per
+  round, so this checks the chain is trimmed away before colouring.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <string>
+#include <vector>
+
+#include "assignments/dg/scc.h"
+#include "catch.h"
+
+SCENARIO("Testing SCC on a small graph") {
+  GIVEN("Two cycles joined by one edge, a self loop and an isolated node") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d", "e", "f", "g"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "a", 2);
+    g.InsertEdge("b", "c", 3);
+    g.InsertEdge("b", "c", 4);
+    g.InsertEdge("c", "d", 5);
+    g.InsertEdge("d", "c", 6);
+    g.InsertEdge("d", "e", 7);
+    g.InsertEdge("e", "e", 8);
+    auto csr = g.Freeze();
+    for (unsigned threads : {1u, 3u}) {
+      gdwg::Scc<std::string, int> scc{csr, threads};
+      WHEN("Components are found with " + std::to_string(threads) + " threads") {
+        THEN("Nodes on a common cycle share a component, numbered by smallest node") {
+          REQUIRE(scc.ComponentCount() == 5);
+          REQUIRE(scc.Components() == std::vector<std::uint32_t>{0, 0, 1, 1, 2, 3, 4});
+          REQUIRE(scc.ComponentOf("d") == 1);
+          REQUIRE(scc.ComponentOf("g") == 4);
+        }
+        THEN("The condensation keeps edges between components with their weights") {
+          auto condensed = scc.Condensation();
+          REQUIRE(condensed.GetNodes() == std::vector<std::uint32_t>{0, 1, 2, 3, 4});
+          REQUIRE(condensed.GetWeights(0, 1) == std::vector<int>{3, 4});
+          REQUIRE(condensed.GetWeights(1, 2) == std::vector<int>{7});
+          REQUIRE(condensed.GetConnected(2).empty());
+          REQUIRE(condensed.GetConnected(4).empty());
+        }
+        THEN("Missing nodes throw") {
+          REQUIRE_THROWS_AS(scc.ComponentOf("z"), std::out_of_range);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Testing SCC on larger graphs") {
+  GIVEN("A graph of many small cycles with chains between them") {
+    gdwg::Graph<int, int> g;
+    const int n = 6000;
+    for (int i = 0; i < n; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < n; ++i) {
+      // Cycles of up to 7 nodes, hopping around so components aren't contiguous
+      int next = (i % 7 == 6) ? i - 6 : i + 1;
+      if (next < n && (i / 7) % 5 != 0)
+        g.InsertEdge((next * 13) % n, (i * 13) % n, 1);
+      // Forward links between cycles, never back
+      if (i + 50 < n && i % 11 == 0)
+        g.InsertEdge((i * 13) % n, ((i + 50) * 13) % n, 2);
+    }
+    auto csr = g.Freeze();
+    WHEN("It is split on one thread and on four") {
+      gdwg::Scc<int, int> serial{csr, 1};
+      gdwg::Scc<int, int> parallel{csr, 4};
+      THEN("Both give the same components") {
+        REQUIRE(serial.ComponentCount() > 1);
+        REQUIRE(serial.ComponentCount() < static_cast<std::size_t>(n));
+        REQUIRE(serial.Components() == parallel.Components());
+      }
+      THEN("The condensation has no cycles") {
+        auto condensed = serial.Condensation().Freeze();
+        gdwg::Scc<std::uint32_t, int> again{condensed, 1};
+        REQUIRE(again.ComponentCount() == condensed.NodeCount());
+        REQUIRE(condensed.NodeCount() == serial.ComponentCount());
+      }
+    }
+  }
+  GIVEN("A chain of 200000 nodes closed into one cycle") {
+    const int n = 200000;
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int i = 0; i < n; ++i) {
+      edges.emplace_back(i, (i + 1) % n, 0);
+    }
+    auto csr = gdwg::Graph<int, int>::FromEdgeList(edges).Freeze();
+    WHEN("It is split on one thread") {
+      gdwg::Scc<int, int> scc{csr, 1};
+      THEN("It is one component") { REQUIRE(scc.ComponentCount() == 1); }
+    }
+  }
+  GIVEN("A chain of 20000 nodes running down from the largest index into a cycle of 3") {
+    const int n = 20000;
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int i = 1; i < n; ++i) {
+      edges.emplace_back(i, i - 1, 0);
+    }
+    edges.emplace_back(0, 2, 0);
+    auto csr = gdwg::Graph<int, int>::FromEdgeList(edges).Freeze();
+    WHEN("It is split on one thread and on four") {
+      gdwg::Scc<int, int> serial{csr, 1};
+      gdwg::Scc<int, int> parallel{csr, 4};
+      THEN("Only the cycle is a component of more than one node") {
+        REQUIRE(serial.ComponentCount() == static_cast<std::size_t>(n - 2));
+        REQUIRE(serial.ComponentOf(1) == serial.ComponentOf(2));
+        REQUIRE(serial.ComponentOf(3) != serial.ComponentOf(2));
+        REQUIRE(serial.Components() == parallel.Components());
+      }
+    }
+  }
+}
@@ -0,0 +1,88 @@
+#ifndef ASSIGNMENTS_DG_SHORTEST_PATH_H_
+#define ASSIGNMENTS_DG_SHORTEST_PATH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "assignments/dg/csr_graph.h"
+
+namespace gdwg {
+
+// Dijkstra's algorithm over a frozen graph, with every buffer kept between queries so
+// repeated queries on the same snapshot don't allocate.
+// E{} is treated as a zero distance, and E needs operator+ and operator<.
+// Negative weights aren't allowed.
+// The snapshot has to outlive this object.
+template <typename N, typename E>
+class ShortestPaths {
+ public:
+  explicit ShortestPaths<N, E>(const CsrGraph<N, E>& g);
+
+  // Single source, finds the distance from source to every node
+  void Run(const N& source);
+
+  // Results of the last Run
+  bool IsReachable(const N& dst) const;
+  const E& DistanceTo(const N& dst) const;
+  // Nodes along a shortest path from the source to dst, both included
+  std::vector<N> PathTo(const N& dst) const;
+
+  // Point to point, searches from both ends at once so it usually settles far fewer nodes.
+  // Both reuse Run's buffers, so Run has to be called again before asking for its results
+  std::optional<E> Distance(const N& src, const N& dst);
+  // Empty if dst can't be reached
+  std::vector<N> Path(const N& src, const N& dst);
+
+ private:
+  // State of one search, valid only where stamp matches the current generation, so
+  // starting a new search doesn't need to clear anything
+  struct Search {
+    std::vector<E> dist;
+    // Previous node on the path, the source is its own parent
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> stamp;
+    // Position in heap, or kSettled once popped
+    std::vector<std::uint32_t> slot;
+    // 4-ary min heap of node indices keyed on dist
+    std::vector<std::uint32_t> heap;
+    std::uint32_t generation = 0;
+
+    void reset(std::size_t n);
+    bool seen(std::uint32_t v) const { return stamp[v] == generation; }
+    bool settled(std::uint32_t v) const { return seen(v) && slot[v] == kSettled; }
+    const E& top() const { return dist[heap.front()]; }
+    // Lowers v's distance to d through from, if that is shorter
+    void relax(std::uint32_t v, std::uint32_t from, const E& d);
+    std::uint32_t pop();
+    void siftUp(std::size_t i);
+    void siftDown(std::size_t i);
+  };
+  static constexpr std::uint32_t kSettled = UINT32_MAX;
+  static constexpr std::size_t kArity = 4;
+
+  const CsrGraph<N, E>& graph;
+  // Built the first time a point to point query needs to search backwards
+  std::optional<CsrGraph<N, E>> reverse;
+  Search forward;
+  Search backward;
+  // Whether forward holds the result of Run rather than a point to point query
+  bool ran = false;
+  std::uint32_t source = 0;
+
+  std::uint32_t indexOf(const N& val, const char* message) const;
+  // Settles the closest node of one side, updating the best meeting point found so far
+  void step(Search& self,
+            const Search& other,
+            const CsrGraph<N, E>& g,
+            std::optional<E>& best,
+            std::uint32_t& meet);
+  // Runs the bidirectional search, meet is where the two halves of the path join
+  std::optional<E> meetInMiddle(std::uint32_t src, std::uint32_t dst, std::uint32_t& meet);
+};
+
+}  // namespace gdwg
+#include "assignments/dg/shortest_path.tpp"
+
+#endif  // ASSIGNMENTS_DG_SHORTEST_PATH_H_
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::ShortestPaths<N, E>::ShortestPaths(const CsrGraph<N, E>& g) : graph{g} {
+  for (const auto& w : g.Weights()) {
+    if (w < E{}) {
+      throw std::runtime_error("Cannot call ShortestPaths on a graph with negative weights");
+    }
+  }
+}
+
+// Starts a new search, only touching the buffers when the graph has grown or the
+// generation counter wraps around
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::Search::reset(std::size_t n) {
+  if (stamp.size() != n || generation == UINT32_MAX) {
+    dist.assign(n, E{});
+    parent.assign(n, 0);
+    stamp.assign(n, 0);
+    slot.assign(n, 0);
+    generation = 0;
+  }
+  ++generation;
+  heap.clear();
+}
+
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::Search::relax(std::uint32_t v, std::uint32_t from, const E& d) {
+  if (!seen(v)) {
+    stamp[v] = generation;
+    dist[v] = d;
+    parent[v] = from;
+    slot[v] = static_cast<std::uint32_t>(heap.size());
+    heap.push_back(v);
+    siftUp(heap.size() - 1);
+  } else if (slot[v] != kSettled && d < dist[v]) {
+    dist[v] = d;
+    parent[v] = from;
+    siftUp(slot[v]);
+  }
+}
+
+template <typename N, typename E>
+std::uint32_t gdwg::ShortestPaths<N, E>::Search::pop() {
+  auto v = heap.front();
+  slot[v] = kSettled;
+  heap.front() = heap.back();
+  heap.pop_back();
+  if (!heap.empty()) {
+    slot[heap.front()] = 0;
+    siftDown(0);
+  }
+  return v;
+}
+
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::Search::siftUp(std::size_t i) {
+  auto v = heap[i];
+  while (i > 0) {
+    auto up = (i - 1) / kArity;
+    if (!(dist[v] < dist[heap[up]]))
+      break;
+    heap[i] = heap[up];
+    slot[heap[i]] = static_cast<std::uint32_t>(i);
+    i = up;
+  }
+  heap[i] = v;
+  slot[v] = static_cast<std::uint32_t>(i);
+}
+
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::Search::siftDown(std::size_t i) {
+  auto v = heap[i];
+  for (;;) {
+    auto first = i * kArity + 1;
+    if (first >= heap.size())
+      break;
+    auto last = std::min(first + kArity, heap.size());
+    auto best = first;
+    for (auto c = first + 1; c < last; ++c) {
+      if (dist[heap[c]] < dist[heap[best]])
+        best = c;
+    }
+    if (!(dist[heap[best]] < dist[v]))
+      break;
+    heap[i] = heap[best];
+    slot[heap[i]] = static_cast<std::uint32_t>(i);
+    i = best;
+  }
+  heap[i] = v;
+  slot[v] = static_cast<std::uint32_t>(i);
+}
+
+template <typename N, typename E>
+std::uint32_t gdwg::ShortestPaths<N, E>::indexOf(const N& val, const char* message) const {
+  auto index = graph.IndexOf(val);
+  if (index == graph.NodeCount()) {
+    throw std::out_of_range(message);
+  }
+  return static_cast<std::uint32_t>(index);
+}
+
+// Finds the distance from source to every node
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::Run(const N& src) {
+  source = indexOf(src, "Cannot call ShortestPaths::Run if source doesn't exist in the graph");
+  ran = true;
+  const auto& offsets = graph.Offsets();
+  const auto& destinations = graph.Destinations();
+  const auto& weights = graph.Weights();
+
+  forward.reset(graph.NodeCount());
+  forward.relax(source, source, E{});
+  while (!forward.heap.empty()) {
+    auto u = forward.pop();
+    for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+      forward.relax(destinations[e], u, forward.dist[u] + weights[e]);
+    }
+  }
+}
+
+// Checks if the last Run reached dst
+template <typename N, typename E>
+bool gdwg::ShortestPaths<N, E>::IsReachable(const N& dst) const {
+  if (!ran) {
+    throw std::runtime_error("Cannot call ShortestPaths::IsReachable without calling Run first");
+  }
+  auto d = graph.IndexOf(dst);
+  return d != graph.NodeCount() && forward.seen(static_cast<std::uint32_t>(d));
+}
+
+template <typename N, typename E>
+const E& gdwg::ShortestPaths<N, E>::DistanceTo(const N& dst) const {
+  if (!IsReachable(dst)) {
+    throw std::out_of_range("Cannot call ShortestPaths::DistanceTo if dst wasn't reached");
+  }
+  return forward.dist[graph.IndexOf(dst)];
+}
+
+template <typename N, typename E>
+std::vector<N> gdwg::ShortestPaths<N, E>::PathTo(const N& dst) const {
+  if (!IsReachable(dst)) {
+    throw std::out_of_range("Cannot call ShortestPaths::PathTo if dst wasn't reached");
+  }
+  std::vector<N> path;
+  auto v = static_cast<std::uint32_t>(graph.IndexOf(dst));
+  for (; v != source; v = forward.parent[v]) {
+    path.push_back(graph.ValueAt(v));
+  }
+  path.push_back(graph.ValueAt(source));
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+template <typename N, typename E>
+void gdwg::ShortestPaths<N, E>::step(Search& self,
+                                     const Search& other,
+                                     const CsrGraph<N, E>& g,
+                                     std::optional<E>& best,
+                                     std::uint32_t& meet) {
+  const auto& offsets = g.Offsets();
+  const auto& destinations = g.Destinations();
+  const auto& weights = g.Weights();
+  auto u = self.pop();
+  for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+    auto v = destinations[e];
+    auto d = self.dist[u] + weights[e];
+    self.relax(v, u, d);
+    if (other.seen(v)) {
+      auto through = d + other.dist[v];
+      if (!best || through < *best) {
+        best = through;
+        meet = v;
+      }
+    }
+  }
+}
+
+template <typename N, typename E>
+std::optional<E> gdwg::ShortestPaths<N, E>::meetInMiddle(std::uint32_t src,
+                                                         std::uint32_t dst,
+                                                         std::uint32_t& meet) {
+  meet = src;
+  if (src == dst)
+    return E{};
+  if (!reverse) {
+    reverse = graph.Transpose();
+  }
+  // forward is about to be overwritten
+  ran = false;
+  forward.reset(graph.NodeCount());
+  backward.reset(graph.NodeCount());
+  forward.relax(src, src, E{});
+  backward.relax(dst, dst, E{});
+
+  std::optional<E> best;
+  while (!forward.heap.empty() && !backward.heap.empty()) {
+    // Nothing left in either heap can make a shorter path
+    if (best && !(forward.top() + backward.top() < *best))
+      break;
+    // Grow whichever side has the smaller frontier
+    if (forward.heap.size() <= backward.heap.size()) {
+      step(forward, backward, graph, best, meet);
+    } else {
+      step(backward, forward, *reverse, best, meet);
+    }
+  }
+  return best;
+}
+
+// Shortest distance from src to dst, if there is a path
+template <typename N, typename E>
+std::optional<E> gdwg::ShortestPaths<N, E>::Distance(const N& src, const N& dst) {
+  auto s = indexOf(src, "Cannot call ShortestPaths::Distance if src or dst don't exist in the graph");
+  auto d = indexOf(dst, "Cannot call ShortestPaths::Distance if src or dst don't exist in the graph");
+  std::uint32_t meet;
+  return meetInMiddle(s, d, meet);
+}
+
+// Nodes along a shortest path from src to dst
+template <typename N, typename E>
+std::vector<N> gdwg::ShortestPaths<N, E>::Path(const N& src, const N& dst) {
+  auto s = indexOf(src, "Cannot call ShortestPaths::Path if src or dst don't exist in the graph");
+  auto d = indexOf(dst, "Cannot call ShortestPaths::Path if src or dst don't exist in the graph");
+  std::uint32_t meet;
+  if (!meetInMiddle(s, d, meet))
+    return {};
+
+  std::vector<N> path;
+  if (s == d) {
+    path.push_back(graph.ValueAt(s));
+    return path;
+  }
+  // Walk back to src from the meeting point, then forwards to dst
+  for (auto v = meet; v != s; v = forward.parent[v]) {
+    path.push_back(graph.ValueAt(v));
+  }
+  path.push_back(graph.ValueAt(s));
+  std::reverse(path.begin(), path.end());
+  for (auto v = meet; v != d;) {
+    v = backward.parent[v];
+    path.push_back(graph.ValueAt(v));
+  }
+  return path;
+}
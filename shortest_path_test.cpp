@@ -0,0 +1,132 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Shortest paths are checked on small hand made graphs where the answer can be
+  worked out by hand, including a direct edge that is longer than a detour,
+  unreachable nodes and self loops.
+
+  The bidirectional search is then checked against the single source search on
+  a larger generated graph, since both have to agree on every distance.
+
+  Buffer reuse is tested by running several queries on the same ShortestPaths
+  object and making sure earlier queries don't leak into later ones.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/shortest_path.h"
+#include "catch.h"
+
+SCENARIO("Testing single source shortest paths") {
+  GIVEN("A graph where the direct edge is longer than a detour") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d", "e"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "c", 2);
+    g.InsertEdge("a", "c", 10);
+    g.InsertEdge("c", "d", 1);
+    g.InsertEdge("d", "d", 7);
+    g.InsertEdge("e", "a", 1);
+    auto csr = g.Freeze();
+    gdwg::ShortestPaths<std::string, int> sp{csr};
+
+    WHEN("Dijkstra is run from a") {
+      sp.Run("a");
+      THEN("Distances and paths take the detour") {
+        REQUIRE(sp.DistanceTo("a") == 0);
+        REQUIRE(sp.DistanceTo("c") == 3);
+        REQUIRE(sp.DistanceTo("d") == 4);
+        REQUIRE(sp.PathTo("d") == std::vector<std::string>{"a", "b", "c", "d"});
+        REQUIRE(sp.PathTo("a") == std::vector<std::string>{"a"});
+      }
+      THEN("Nodes with no path from a aren't reachable") {
+        REQUIRE(!sp.IsReachable("e"));
+        REQUIRE(!sp.IsReachable("z"));
+        REQUIRE_THROWS_AS(sp.DistanceTo("e"), std::out_of_range);
+        REQUIRE_THROWS_AS(sp.PathTo("e"), std::out_of_range);
+      }
+    }
+    WHEN("Dijkstra is run again from another node") {
+      sp.Run("a");
+      sp.Run("c");
+      THEN("Only the second run's results remain") {
+        REQUIRE(!sp.IsReachable("a"));
+        REQUIRE(sp.DistanceTo("d") == 1);
+      }
+    }
+    WHEN("Dijkstra is run from a missing node or results are asked for first") {
+      THEN("An exception is thrown") {
+        REQUIRE_THROWS_AS(sp.IsReachable("a"), std::runtime_error);
+        REQUIRE_THROWS_AS(sp.Run("z"), std::out_of_range);
+      }
+    }
+  }
+  GIVEN("A graph with a negative weight") {
+    gdwg::Graph<char, double> g{'a', 'b'};
+    g.InsertEdge('a', 'b', -0.5);
+    auto csr = g.Freeze();
+    THEN("It is rejected") {
+      REQUIRE_THROWS_AS((gdwg::ShortestPaths<char, double>{csr}), std::runtime_error);
+    }
+  }
+}
+
+SCENARIO("Testing point to point shortest paths") {
+  GIVEN("The same graph as above") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d", "e"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("b", "c", 2);
+    g.InsertEdge("a", "c", 10);
+    g.InsertEdge("c", "d", 1);
+    g.InsertEdge("e", "a", 1);
+    auto csr = g.Freeze();
+    gdwg::ShortestPaths<std::string, int> sp{csr};
+
+    WHEN("Pairs of nodes are queried") {
+      THEN("The bidirectional search finds the shortest path") {
+        REQUIRE(sp.Distance("e", "d") == std::optional<int>{5});
+        REQUIRE(sp.Path("e", "d") == std::vector<std::string>{"e", "a", "b", "c", "d"});
+        REQUIRE(sp.Path("b", "c") == std::vector<std::string>{"b", "c"});
+        REQUIRE(sp.Distance("c", "c") == std::optional<int>{0});
+        REQUIRE(sp.Path("c", "c") == std::vector<std::string>{"c"});
+      }
+      THEN("Unreachable pairs give nothing") {
+        REQUIRE(!sp.Distance("d", "a"));
+        REQUIRE(sp.Path("d", "a").empty());
+        REQUIRE_THROWS_AS(sp.Distance("a", "z"), std::out_of_range);
+      }
+    }
+  }
+  GIVEN("A larger generated graph") {
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int i = 0; i < 200; ++i) {
+      edges.emplace_back(i, (i * 7 + 3) % 200, (i * 13) % 17 + 1);
+      edges.emplace_back(i, (i * 11 + 5) % 200, (i * 5) % 23);
+      edges.emplace_back(i, (i + 1) % 200, 40);
+    }
+    auto csr = gdwg::Graph<int, int>::FromEdgeList(edges).Freeze();
+    gdwg::ShortestPaths<int, int> single{csr};
+    gdwg::ShortestPaths<int, int> pair{csr};
+
+    WHEN("Every distance from a few sources is worked out both ways") {
+      THEN("Both searches agree") {
+        for (int src = 0; src < 200; src += 37) {
+          single.Run(src);
+          for (int dst = 0; dst < 200; ++dst) {
+            auto d = pair.Distance(src, dst);
+            REQUIRE(d.has_value());
+            REQUIRE(*d == single.DistanceTo(dst));
+            auto path = pair.Path(src, dst);
+            REQUIRE(path.front() == src);
+            REQUIRE(path.back() == dst);
+          }
+        }
+      }
+    }
+  }
+}
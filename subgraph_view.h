@@ -0,0 +1,118 @@
+#ifndef ASSIGNMENTS_DG_SUBGRAPH_VIEW_H_
+#define ASSIGNMENTS_DG_SUBGRAPH_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+// Read-only view of part of a Graph, with the same read API and iteration order.
+// A view is a sorted list of the graph's nodes it keeps and an optional edge filter. Nothing
+// is copied, edges are checked as they're read, so a view is only good until the graph next
+// changes. Materialize() copies it out into a graph of its own.
+// Views are made with Induced (some nodes and the edges between them), Neighbourhood (nodes
+// within k out-edges of one node) or Filtered (every node, only the edges a filter accepts),
+// and Filter narrows any of them further.
+template <typename N, typename E, typename I = NoInstrumentation>
+class SubgraphView {
+ public:
+  using GraphType = Graph<N, E, I>;
+  using EdgeFilter = std::function<bool(const N& src, const N& dst, const E& w)>;
+
+  // Nodes of g that are in nodes, values that aren't nodes of g are left out
+  static SubgraphView<N, E, I> Induced(const GraphType& g, const std::vector<N>& nodes);
+  // Nodes of g no more than k out-edges away from src, src included
+  static SubgraphView<N, E, I> Neighbourhood(const GraphType& g, const N& src, std::size_t k);
+  // Every node of g, with the edges filter accepts
+  static SubgraphView<N, E, I> Filtered(const GraphType& g, EdgeFilter filter);
+
+  // Same nodes, keeping only the edges this view and filter both accept
+  SubgraphView<N, E, I> Filter(EdgeFilter filter) const;
+
+  bool IsNode(const N& val) const;
+  bool IsConnected(const N& src, const N& dst) const;
+  std::vector<N> GetNodes() const;
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+
+  // A graph of just the view's nodes and edges, built in one pass over the view
+  GraphType Materialize() const;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    using reference = std::tuple<const N&, const N&, const E&>;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+
+    //*, ++, --, == and !=
+    reference operator*() const;
+    const_iterator& operator++();
+    const_iterator operator++(int);
+    const_iterator& operator--();
+    const_iterator operator--(int);
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.view_ == rhs.view_ && lhs.node_ == rhs.node_ && lhs.edge_ == rhs.edge_;
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    const SubgraphView* view_ = nullptr;
+    std::size_t node_ = 0;  // index into members, members.size() at end
+    std::size_t edge_ = 0;  // index into that node's out-edges
+
+    friend class SubgraphView;
+    const_iterator(const SubgraphView* view, std::size_t node, std::size_t edge)
+      : view_{view}, node_{node}, edge_{edge} {}
+  };
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  const_iterator begin() const;
+  const_iterator end() const { return const_iterator{this, members.size(), 0}; }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+  const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+  const_iterator find(const N& source, const N& dest, const E& weight) const;
+
+ private:
+  using Node = typename GraphType::Node;
+
+  const GraphType* graph;
+  // The nodes kept, sorted by value
+  std::vector<const Node*> members;
+  // Indexed by node id, left empty when every node is kept
+  std::vector<bool> inView;
+  // Empty to accept every edge between members
+  EdgeFilter filter;
+
+  explicit SubgraphView<N, E, I>(const GraphType& g) : graph{&g} {}
+
+  // Sorts members and marks them in inView
+  void index();
+  // Node of val if it's in the view, otherwise nullptr
+  const Node* member(const N& val) const;
+  // Whether the view keeps src's i-th out-edge
+  bool accepts(const Node* src, std::size_t i) const;
+  // First accepted edge at or after (node, edge), or end()
+  const_iterator seekForward(std::size_t node, std::size_t edge) const;
+};
+
+}  // namespace gdwg
+#include "assignments/dg/subgraph_view.tpp"
+
+#endif  // ASSIGNMENTS_DG_SUBGRAPH_VIEW_H_
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E, typename I>
+gdwg::SubgraphView<N, E, I> gdwg::SubgraphView<N, E, I>::Induced(const GraphType& g,
+                                                                 const std::vector<N>& nodes) {
+  SubgraphView<N, E, I> view{g};
+  for (const auto& val : nodes) {
+    auto id = g.idOf(val);
+    if (id != GraphType::kNoId)
+      view.members.push_back(g.nodesById[id]);
+  }
+  view.index();
+  return view;
+}
+
+// Breadth first, one level per hop
+template <typename N, typename E, typename I>
+gdwg::SubgraphView<N, E, I>
+gdwg::SubgraphView<N, E, I>::Neighbourhood(const GraphType& g, const N& src, std::size_t k) {
+  auto id = g.idOf(src);
+  if (id == GraphType::kNoId) {
+    throw std::out_of_range(
+        "Cannot call SubgraphView::Neighbourhood if src doesn't exist in the graph");
+  }
+  SubgraphView<N, E, I> view{g};
+  view.inView.assign(g.IdBound(), false);
+  view.inView[id] = true;
+  view.members.push_back(g.nodesById[id]);
+  std::size_t first = 0;
+  for (std::size_t hop = 0; hop < k && first < view.members.size(); ++hop) {
+    const auto last = view.members.size();
+    for (auto i = first; i < last; ++i) {
+      const auto node = view.members[i];
+      for (std::size_t j = 0; j < node->degree(); ++j) {
+        auto dst = g.destNode(node, j);
+        if (!view.inView[dst->getId()]) {
+          view.inView[dst->getId()] = true;
+          view.members.push_back(dst);
+        }
+      }
+    }
+    first = last;
+  }
+  view.index();
+  return view;
+}
+
+// nodegraph is ordered, so its nodes are already sorted
+template <typename N, typename E, typename I>
+gdwg::SubgraphView<N, E, I> gdwg::SubgraphView<N, E, I>::Filtered(const GraphType& g,
+                                                                  EdgeFilter filter) {
+  SubgraphView<N, E, I> view{g};
+  view.members.reserve(g.nodegraph.size());
+  for (const auto& [key, val] : g.nodegraph) {
+    view.members.push_back(val);
+    (void)key;
+  }
+  view.filter = std::move(filter);
+  return view;
+}
+
+template <typename N, typename E, typename I>
+gdwg::SubgraphView<N, E, I> gdwg::SubgraphView<N, E, I>::Filter(EdgeFilter narrower) const {
+  SubgraphView<N, E, I> view{*this};
+  if (filter) {
+    view.filter = [wider = filter, narrower = std::move(narrower)](
+                      const N& src, const N& dst, const E& w) {
+      return wider(src, dst, w) && narrower(src, dst, w);
+    };
+  } else {
+    view.filter = std::move(narrower);
+  }
+  return view;
+}
+
+template <typename N, typename E, typename I>
+void gdwg::SubgraphView<N, E, I>::index() {
+  std::sort(members.begin(), members.end(), [](const Node* a, const Node* b) {
+    return a->getValueRef() < b->getValueRef();
+  });
+  members.erase(std::unique(members.begin(), members.end()), members.end());
+  inView.assign(graph->IdBound(), false);
+  for (const auto& node : members) {
+    inView[node->getId()] = true;
+  }
+}
+
+template <typename N, typename E, typename I>
+const typename gdwg::SubgraphView<N, E, I>::Node*
+gdwg::SubgraphView<N, E, I>::member(const N& val) const {
+  auto id = graph->idOf(val);
+  if (id == GraphType::kNoId || (!inView.empty() && !inView[id]))
+    return nullptr;
+  return graph->nodesById[id];
+}
+
+template <typename N, typename E, typename I>
+bool gdwg::SubgraphView<N, E, I>::accepts(const Node* src, std::size_t i) const {
+  if (!inView.empty() && !inView[graph->destNode(src, i)->getId()])
+    return false;
+  return !filter || filter(src->getValueRef(), src->destAt(i), src->weightAt(i));
+}
+
+// Checks if node exists
+template <typename N, typename E, typename I>
+bool gdwg::SubgraphView<N, E, I>::IsNode(const N& val) const {
+  return member(val) != nullptr;
+}
+
+// Checks if there is an edge from src to dst
+template <typename N, typename E, typename I>
+bool gdwg::SubgraphView<N, E, I>::IsConnected(const N& src, const N& dst) const {
+  auto s = member(src);
+  auto d = member(dst);
+  if (s == nullptr || d == nullptr) {
+    throw std::runtime_error(
+        "Cannot call SubgraphView::IsConnected if src or dst node don't exist in the view");
+  }
+  if (!filter)
+    return s->hasEdgeTo(d);
+  auto [first, last] = s->destRange(dst);
+  for (auto i = first; i < last; ++i) {
+    if (accepts(s, i))
+      return true;
+  }
+  return false;
+}
+
+// Creates a vector containing all nodes in the view
+template <typename N, typename E, typename I>
+std::vector<N> gdwg::SubgraphView<N, E, I>::GetNodes() const {
+  std::vector<N> ret;
+  ret.reserve(members.size());
+  for (const auto& node : members) {
+    ret.push_back(node->getValueRef());
+  }
+  return ret;
+}
+
+// Creates a vector containing the destination of every edge out of src in the view
+template <typename N, typename E, typename I>
+std::vector<N> gdwg::SubgraphView<N, E, I>::GetConnected(const N& src) const {
+  auto s = member(src);
+  if (s == nullptr) {
+    throw std::out_of_range(
+        "Cannot call SubgraphView::GetConnected if src doesn't exist in the view");
+  }
+  std::vector<N> ret;
+  for (std::size_t i = 0; i < s->degree(); ++i) {
+    if (accepts(s, i))
+      ret.push_back(s->destAt(i));
+  }
+  return ret;
+}
+
+// Creates a vector containing all weights of edges from src to dst in the view
+template <typename N, typename E, typename I>
+std::vector<E> gdwg::SubgraphView<N, E, I>::GetWeights(const N& src, const N& dst) const {
+  auto s = member(src);
+  if (s == nullptr || member(dst) == nullptr) {
+    throw std::out_of_range(
+        "Cannot call SubgraphView::GetWeights if src or dst node don't exist in the view");
+  }
+  std::vector<E> ret;
+  auto [first, last] = s->destRange(dst);
+  for (auto i = first; i < last; ++i) {
+    if (accepts(s, i))
+      ret.push_back(s->weightAt(i));
+  }
+  return ret;
+}
+
+// Nodes go in first so ones without edges are kept, then every edge in one batch
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::GraphType gdwg::SubgraphView<N, E, I>::Materialize() const {
+  GraphType g;
+  std::vector<std::tuple<N, N, E>> edges;
+  for (const auto& node : members) {
+    g.InsertNode(node->getValueRef());
+    for (std::size_t i = 0; i < node->degree(); ++i) {
+      if (accepts(node, i))
+        edges.emplace_back(node->getValueRef(), node->destAt(i), node->weightAt(i));
+    }
+  }
+  g.InsertEdges(edges.begin(), edges.end());
+  return g;
+}
+
+// Iterator related functions
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator
+gdwg::SubgraphView<N, E, I>::seekForward(std::size_t node, std::size_t edge) const {
+  for (; node < members.size(); ++node, edge = 0) {
+    for (; edge < members[node]->degree(); ++edge) {
+      if (accepts(members[node], edge))
+        return const_iterator{this, node, edge};
+    }
+  }
+  return end();
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator gdwg::SubgraphView<N, E, I>::begin() const {
+  return seekForward(0, 0);
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator
+gdwg::SubgraphView<N, E, I>::find(const N& source, const N& dest, const E& weight) const {
+  auto s = member(source);
+  if (s == nullptr || member(dest) == nullptr)
+    return end();
+  auto pos = s->lowerBound(dest, weight);
+  if (pos == s->degree() || s->destAt(pos) != dest || s->weightAt(pos) != weight ||
+      !accepts(s, pos))
+    return end();
+  auto node = std::lower_bound(members.begin(), members.end(), s,
+                               [](const Node* a, const Node* b) {
+                                 return a->getValueRef() < b->getValueRef();
+                               });
+  return const_iterator{this, static_cast<std::size_t>(node - members.begin()), pos};
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator::reference
+    gdwg::SubgraphView<N, E, I>::const_iterator::operator*() const {
+  const auto node = view_->members[node_];
+  return {node->getValueRef(), node->destAt(edge_), node->weightAt(edge_)};
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator&
+gdwg::SubgraphView<N, E, I>::const_iterator::operator++() {
+  *this = view_->seekForward(node_, edge_ + 1);
+  return *this;
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator
+gdwg::SubgraphView<N, E, I>::const_iterator::operator++(int) {
+  auto copy{*this};
+  ++(*this);
+  return copy;
+}
+
+// Steps back over rejected edges and nodes without edges, end() starts past the last node
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator&
+gdwg::SubgraphView<N, E, I>::const_iterator::operator--() {
+  do {
+    while (edge_ == 0) {
+      --node_;
+      edge_ = view_->members[node_]->degree();
+    }
+    --edge_;
+  } while (!view_->accepts(view_->members[node_], edge_));
+  return *this;
+}
+
+template <typename N, typename E, typename I>
+typename gdwg::SubgraphView<N, E, I>::const_iterator
+gdwg::SubgraphView<N, E, I>::const_iterator::operator--(int) {
+  auto copy{*this};
+  --(*this);
+  return copy;
+}
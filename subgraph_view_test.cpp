@@ -0,0 +1,168 @@
+/*
+
+  == Explanation and rational of testing ==
+
+  Each kind of view is checked on a small graph that can be worked out by
+  hand: an induced view over some nodes, a weight range filter over the whole
+  graph, and neighbourhoods of 0, 1 and 2 hops, with the read API, exceptions
+  and both directions of iteration.
+
+  Every view is then materialized and compared against the old way of getting
+  the same graph, copying the whole thing and deleting what's outside it,
+  which also checks that iteration and Materialize agree.
+
+  A larger generated graph checks a filtered neighbourhood against the same
+  thing worked out by hand from the full graph's edges.
+
+  Exceptions are tested with REQUIRE_THROWS_AS().
+*/
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/subgraph_view.h"
+#include "catch.h"
+
+namespace {
+
+using Edges = std::vector<std::tuple<std::string, std::string, int>>;
+
+// Graph's iterator has no iterator_traits, so the edges are pushed one at a time
+template <typename Range>
+Edges walk(const Range& range) {
+  Edges edges;
+  for (const auto& [src, dst, w] : range) {
+    edges.emplace_back(src, dst, w);
+  }
+  return edges;
+}
+
+}  // namespace
+
+SCENARIO("Testing subgraph views on a small graph") {
+  GIVEN("A graph of five nodes, one without any edges") {
+    gdwg::Graph<std::string, int> g{"a", "b", "c", "d", "e"};
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("a", "b", 7);
+    g.InsertEdge("a", "c", 2);
+    g.InsertEdge("b", "c", 3);
+    g.InsertEdge("c", "a", 4);
+    g.InsertEdge("c", "d", 5);
+    g.InsertEdge("d", "d", 6);
+    using View = gdwg::SubgraphView<std::string, int>;
+
+    WHEN("A view is induced over a, c, d and a value that isn't a node") {
+      auto view = View::Induced(g, {"d", "a", "c", "z", "a"});
+      THEN("Only edges between those nodes are in it") {
+        REQUIRE(view.GetNodes() == std::vector<std::string>{"a", "c", "d"});
+        REQUIRE(!view.IsNode("b"));
+        REQUIRE(view.GetConnected("a") == std::vector<std::string>{"c"});
+        REQUIRE(view.IsConnected("c", "d"));
+        REQUIRE(walk(view) == Edges{{"a", "c", 2}, {"c", "a", 4}, {"c", "d", 5}, {"d", "d", 6}});
+        REQUIRE(Edges(view.rbegin(), view.rend()) ==
+                Edges{{"d", "d", 6}, {"c", "d", 5}, {"c", "a", 4}, {"a", "c", 2}});
+        REQUIRE(view.find("c", "a", 4) != view.end());
+        REQUIRE(view.find("a", "b", 1) == view.end());
+      }
+      THEN("Nodes outside it throw") {
+        REQUIRE_THROWS_AS(view.IsConnected("a", "b"), std::runtime_error);
+        REQUIRE_THROWS_AS(view.GetConnected("b"), std::out_of_range);
+        REQUIRE_THROWS_AS(view.GetWeights("a", "b"), std::out_of_range);
+      }
+      THEN("Materializing it gives what deleting everything else would") {
+        auto copy = g;
+        copy.DeleteNode("b");
+        copy.DeleteNode("e");
+        REQUIRE(view.Materialize() == copy);
+      }
+    }
+
+    WHEN("The whole graph is filtered to weights of 2 to 5") {
+      auto view =
+          View::Filtered(g, [](const auto&, const auto&, int w) { return w >= 2 && w <= 5; });
+      THEN("Every node is kept, but only those edges") {
+        REQUIRE(view.GetNodes() == g.GetNodes());
+        REQUIRE(view.GetWeights("a", "b").empty());
+        REQUIRE(!view.IsConnected("a", "b"));
+        REQUIRE(view.IsConnected("b", "c"));
+        REQUIRE(walk(view) == Edges{{"a", "c", 2}, {"b", "c", 3}, {"c", "a", 4}, {"c", "d", 5}});
+        auto it = view.end();
+        REQUIRE(std::get<2>(*--it) == 5);
+      }
+      AND_WHEN("It is narrowed to edges out of c") {
+        auto narrower = view.Filter([](const auto& src, const auto&, int) { return src == "c"; });
+        THEN("Both filters apply") {
+          REQUIRE(walk(narrower) == Edges{{"c", "a", 4}, {"c", "d", 5}});
+          REQUIRE(walk(view).size() == 4);
+        }
+      }
+    }
+
+    WHEN("Neighbourhoods of a are taken") {
+      auto none = View::Neighbourhood(g, "a", 0);
+      auto one = View::Neighbourhood(g, "a", 1);
+      auto two = View::Neighbourhood(g, "a", 2);
+      THEN("Each hop adds the nodes it reaches") {
+        REQUIRE(none.GetNodes() == std::vector<std::string>{"a"});
+        REQUIRE(none.begin() == none.end());
+        REQUIRE(one.GetNodes() == std::vector<std::string>{"a", "b", "c"});
+        REQUIRE(one.GetWeights("a", "b") == std::vector<int>{1, 7});
+        REQUIRE(two.GetNodes() == std::vector<std::string>{"a", "b", "c", "d"});
+        REQUIRE(walk(two.Materialize()) == walk(two));
+      }
+      THEN("A missing centre throws") {
+        REQUIRE_THROWS_AS(View::Neighbourhood(g, "z", 1), std::out_of_range);
+      }
+    }
+  }
+}
+
+SCENARIO("Testing subgraph views on a larger graph") {
+  GIVEN("A generated graph and a filtered 3 hop neighbourhood in it") {
+    gdwg::Graph<int, int> g;
+    const int n = 5000;
+    for (int i = 0; i < n; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < n; ++i) {
+      for (int k = 1; k <= 3; ++k) {
+        g.InsertEdge(i, (i * 17 + k * 101) % n, (i + k) % 10);
+      }
+    }
+    auto view = gdwg::SubgraphView<int, int>::Neighbourhood(g, 0, 3).Filter(
+        [](int, int, int w) { return w < 5; });
+    WHEN("The same nodes and edges are worked out from the full graph") {
+      std::vector<int> nodes{0};
+      for (int hop = 0; hop < 3; ++hop) {
+        auto next = nodes;
+        for (const auto& u : nodes) {
+          for (const auto& v : g.GetConnected(u)) {
+            next.push_back(v);
+          }
+        }
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        nodes = next;
+      }
+      std::vector<std::tuple<int, int, int>> edges;
+      for (const auto& [src, dst, w] : g) {
+        if (w < 5 && std::binary_search(nodes.begin(), nodes.end(), src) &&
+            std::binary_search(nodes.begin(), nodes.end(), dst))
+          edges.emplace_back(src, dst, w);
+      }
+      THEN("The view has exactly those") {
+        REQUIRE(view.GetNodes() == nodes);
+        REQUIRE(std::vector<std::tuple<int, int, int>>(view.begin(), view.end()) == edges);
+        auto materialized = view.Materialize();
+        REQUIRE(materialized.GetNodes() == nodes);
+        std::vector<std::tuple<int, int, int>> copied;
+        for (const auto& [src, dst, w] : materialized) {
+          copied.emplace_back(src, dst, w);
+        }
+        REQUIRE(copied == edges);
+      }
+    }
+  }
+}
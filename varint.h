@@ -0,0 +1,45 @@
+#ifndef ASSIGNMENTS_DG_VARINT_H_
+#define ASSIGNMENTS_DG_VARINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gdwg {
+
+namespace detail {
+
+// Seven bits a byte, low bits first, the top bit set on every byte but the last
+inline void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline std::uint64_t GetVarint(const std::uint8_t* bytes, std::size_t& pos) {
+  std::uint64_t value = 0;
+  unsigned shift = 0;
+  std::uint8_t byte;
+  do {
+    byte = bytes[pos++];
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+  return value;
+}
+
+// Small negative numbers to small unsigned ones, so they take few varint bytes too
+inline std::uint64_t ZigZag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+inline std::int64_t UnZigZag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+}  // namespace detail
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_VARINT_H_